@@ -0,0 +1,203 @@
+/*
+	Allocation test for the polygon drawing routines
+
+	Checks that FillTexturedPolygon() and DrawPolygonDecal() dont allocate
+
+	Global operator new is replaced with one that counts calls. A few
+	frames are drawn to let the decal arena grow, then every following
+	frame draws textured polygons into a sprite and polygon decals onto
+	the screen, and any allocation made by those calls is reported. The
+	program exits with 1 if there were any, so it also runs headless:
+
+		g++ -std=c++17 -O2 -I. examples/TEST_Allocations.cpp -DOLC_PGE_HEADLESS -lpthread
+
+	License (OLC-3)
+	~~~~~~~~~~~~~~~
+
+	Copyright 2018 - 2024 OneLoneCoder.com
+
+	Redistribution and use in source and binary forms, with or without
+	modification, are permitted provided that the following conditions
+	are met:
+
+	1. Redistributions or derivations of source code must retain the above
+	copyright notice, this list of conditions and the following disclaimer.
+
+	2. Redistributions or derivative works in binary form must reproduce
+	the above copyright notice. This list of conditions and the following
+	disclaimer must be reproduced in the documentation and/or other
+	materials provided with the distribution.
+
+	3. Neither the name of the copyright holder nor the names of its
+	contributors may be used to endorse or promote products derived
+	from this software without specific prior written permission.
+
+	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+	A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+	HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+	SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+	LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+	DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+	THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+	(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+	OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+	Links
+	~~~~~
+	YouTube:	https://www.youtube.com/javidx9
+	Discord:	https://discord.gg/WhwHUMV
+	Twitter:	https://www.twitter.com/javidx9
+	Twitch:		https://www.twitch.tv/javidx9
+	GitHub:		https://www.github.com/onelonecoder
+	Homepage:	https://www.onelonecoder.com
+
+	Author
+	~~~~~~
+	David Barr, aka javidx9, ©OneLoneCoder 2019, 2020, 2021, 2022, 2023, 2024
+
+*/
+
+#define OLC_PGE_APPLICATION
+#include "olcPixelGameEngine.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Every allocation made anywhere in the program goes through here
+static std::atomic<size_t> nAllocations{ 0 };
+
+void* operator new(std::size_t nSize)
+{
+	nAllocations++;
+	if (void* p = std::malloc(nSize ? nSize : 1)) return p;
+	throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t nSize)
+{
+	return operator new(nSize);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { operator delete(p); }
+void operator delete[](void* p, std::size_t) noexcept { operator delete(p); }
+
+class Test_Allocations : public olc::PixelGameEngine
+{
+public:
+	Test_Allocations()
+	{
+		sAppName = "Test_Allocations";
+	}
+
+	int nResult = 0;
+
+protected:
+	static constexpr int nWarmUpFrames = 3;
+	static constexpr int nTestFrames = 20;
+	static constexpr uint32_t nPoints = 6;
+
+	olc::Sprite* sprTarget = nullptr;
+	olc::Sprite* sprTexture = nullptr;
+	olc::Decal* decTexture = nullptr;
+
+	olc::vf2d vPos[nPoints];
+	olc::vf2d vUV[nPoints];
+	olc::Pixel pColour[nPoints];
+	float fDepth[nPoints];
+	std::vector<olc::vf2d> vecPos, vecUV;
+	std::vector<olc::Pixel> vecColour;
+
+	int nFrame = 0;
+	size_t nTexturedPolygon = 0;
+	size_t nPolygonDecal = 0;
+
+	// Number of allocations made by func
+	template<typename F>
+	size_t Count(F func)
+	{
+		const size_t nBefore = nAllocations;
+		func();
+		return nAllocations - nBefore;
+	}
+
+public:
+	bool OnUserCreate() override
+	{
+		sprTarget = new olc::Sprite(256, 240);
+		sprTexture = new olc::Sprite(16, 16);
+		for (int y = 0; y < 16; y++)
+			for (int x = 0; x < 16; x++)
+				sprTexture->SetPixel(x, y, (x ^ y) & 1 ? olc::WHITE : olc::DARK_GREY);
+		decTexture = new olc::Decal(sprTexture);
+
+		for (uint32_t i = 0; i < nPoints; i++)
+		{
+			const float fAngle = 2.0f * 3.14159f * float(i) / float(nPoints);
+			vPos[i] = olc::vf2d(128.0f, 120.0f) + olc::vf2d(std::cos(fAngle), std::sin(fAngle)) * 100.0f;
+			vUV[i] = olc::vf2d(0.5f, 0.5f) + olc::vf2d(std::cos(fAngle), std::sin(fAngle)) * 0.5f;
+			pColour[i] = olc::Pixel(uint8_t(i * 40), 255, 255);
+			fDepth[i] = 1.0f;
+		}
+		vecPos.assign(vPos, vPos + nPoints);
+		vecUV.assign(vUV, vUV + nPoints);
+		vecColour.assign(pColour, pColour + nPoints);
+		return true;
+	}
+
+	bool OnUserUpdate(float fElapsedTime) override
+	{
+		const size_t nTextured = Count([&]()
+		{
+			SetDrawTarget(sprTarget);
+			FillTexturedPolygon(vPos, vUV, pColour, nPoints, sprTexture, olc::DecalStructure::FAN);
+			FillTexturedPolygon(vecPos, vecUV, vecColour, sprTexture, olc::DecalStructure::FAN);
+			SetDrawTarget(nullptr);
+		});
+
+		const size_t nDecal = Count([&]()
+		{
+			for (int i = 0; i < 100; i++)
+			{
+				DrawPolygonDecal(decTexture, vPos, vUV, pColour, nPoints);
+				DrawPolygonDecal(decTexture, vPos, fDepth, vUV, pColour, nPoints, olc::YELLOW);
+				DrawPolygonDecal(decTexture, vecPos, vecUV, vecColour);
+			}
+		});
+
+		if (nFrame >= nWarmUpFrames)
+		{
+			nTexturedPolygon += nTextured;
+			nPolygonDecal += nDecal;
+		}
+
+		if (++nFrame < nWarmUpFrames + nTestFrames)
+			return true;
+
+		std::cout << "Allocations over " << nTestFrames << " frames\n"
+			<< "  FillTexturedPolygon " << nTexturedPolygon << "\n"
+			<< "  DrawPolygonDecal    " << nPolygonDecal << "\n";
+		nResult = (nTexturedPolygon || nPolygonDecal) ? 1 : 0;
+		return false;
+	}
+
+	bool OnUserDestroy() override
+	{
+		delete decTexture;
+		delete sprTexture;
+		delete sprTarget;
+		return true;
+	}
+};
+
+int main()
+{
+	Test_Allocations demo;
+	if (demo.Construct(256, 240, 2, 2))
+		demo.Start();
+	return demo.nResult;
+}
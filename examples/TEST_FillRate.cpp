@@ -0,0 +1,121 @@
+/*
+	Benchmark for FillRect() and Clear()
+
+	Times FillRect() in NORMAL and ALPHA pixel modes, and Clear(), on a
+	1920x1080 draw target, and prints the average of 20 runs of each. It
+	does its work in OnUserCreate() and then quits, so it also runs
+	headless:
+
+		g++ -std=c++17 -O2 -I. examples/TEST_FillRate.cpp -DOLC_PGE_HEADLESS -lpthread
+
+	License (OLC-3)
+	~~~~~~~~~~~~~~~
+
+	Copyright 2018 - 2024 OneLoneCoder.com
+
+	Redistribution and use in source and binary forms, with or without
+	modification, are permitted provided that the following conditions
+	are met:
+
+	1. Redistributions or derivations of source code must retain the above
+	copyright notice, this list of conditions and the following disclaimer.
+
+	2. Redistributions or derivative works in binary form must reproduce
+	the above copyright notice. This list of conditions and the following
+	disclaimer must be reproduced in the documentation and/or other
+	materials provided with the distribution.
+
+	3. Neither the name of the copyright holder nor the names of its
+	contributors may be used to endorse or promote products derived
+	from this software without specific prior written permission.
+
+	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+	A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+	HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+	SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+	LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+	DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+	THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+	(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+	OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+	Links
+	~~~~~
+	YouTube:	https://www.youtube.com/javidx9
+	Discord:	https://discord.gg/WhwHUMV
+	Twitter:	https://www.twitter.com/javidx9
+	Twitch:		https://www.twitch.tv/javidx9
+	GitHub:		https://www.github.com/onelonecoder
+	Homepage:	https://www.onelonecoder.com
+
+	Author
+	~~~~~~
+	David Barr, aka javidx9, ©OneLoneCoder 2019, 2020, 2021, 2022, 2023, 2024
+
+*/
+
+#define OLC_PGE_APPLICATION
+#include "olcPixelGameEngine.h"
+
+class Benchmark_FillRate : public olc::PixelGameEngine
+{
+public:
+	Benchmark_FillRate()
+	{
+		sAppName = "Benchmark_FillRate";
+	}
+
+protected:
+	static constexpr int nRuns = 20;
+
+	// Average milliseconds of nRuns calls of func
+	template<typename F>
+	double Time(F func)
+	{
+		func(); // warm up
+		auto tp1 = std::chrono::steady_clock::now();
+		for (int i = 0; i < nRuns; i++) func();
+		auto tp2 = std::chrono::steady_clock::now();
+		return std::chrono::duration<double, std::milli>(tp2 - tp1).count() / nRuns;
+	}
+
+public:
+	bool OnUserCreate() override
+	{
+		olc::Sprite target(1920, 1080);
+		SetDrawTarget(&target);
+
+		SetPixelMode(olc::Pixel::NORMAL);
+		const double fNormal = Time([&]() { FillRect(0, 0, 1920, 1080, olc::Pixel(200, 100, 50)); });
+
+		SetPixelMode(olc::Pixel::ALPHA);
+		const double fAlpha = Time([&]() { FillRect(0, 0, 1920, 1080, olc::Pixel(200, 100, 50, 128)); });
+
+		SetPixelMode(olc::Pixel::NORMAL);
+		const double fClear = Time([&]() { Clear(olc::DARK_BLUE); });
+
+		SetDrawTarget(nullptr);
+
+		std::cout << std::fixed << std::setprecision(2)
+			<< "1920x1080, average of " << nRuns << " runs\n"
+			<< "  FillRect NORMAL " << fNormal << " ms\n"
+			<< "  FillRect ALPHA  " << fAlpha << " ms\n"
+			<< "  Clear           " << fClear << " ms\n";
+		return false;
+	}
+
+	bool OnUserUpdate(float fElapsedTime) override
+	{
+		return false;
+	}
+};
+
+int main()
+{
+	Benchmark_FillRate demo;
+	if (demo.Construct(256, 240, 2, 2))
+		demo.Start();
+	return 0;
+}
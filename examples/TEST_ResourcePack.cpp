@@ -0,0 +1,245 @@
+/*
+	ResourcePack round trip test
+
+	Packs a stored file, a compressed one, an empty one and a bigger binary
+	one, both with and without a key, then loads each pack back, checks it
+	with VerifyPack() and compares every file byte for byte. A wrong key and
+	a damaged index must both make LoadPack() fail. It prints each check,
+	exits with 1 if any failed, and runs headless:
+
+		g++ -std=c++17 -O2 -I. examples/TEST_ResourcePack.cpp -DOLC_PGE_HEADLESS -lpthread
+
+	License (OLC-3)
+	~~~~~~~~~~~~~~~
+
+	Copyright 2018 - 2024 OneLoneCoder.com
+
+	Redistribution and use in source and binary forms, with or without
+	modification, are permitted provided that the following conditions
+	are met:
+
+	1. Redistributions or derivations of source code must retain the above
+	copyright notice, this list of conditions and the following disclaimer.
+
+	2. Redistributions or derivative works in binary form must reproduce
+	the above copyright notice. This list of conditions and the following
+	disclaimer must be reproduced in the documentation and/or other
+	materials provided with the distribution.
+
+	3. Neither the name of the copyright holder nor the names of its
+	contributors may be used to endorse or promote products derived
+	from this software without specific prior written permission.
+
+	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+	A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+	HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+	SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+	LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+	DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+	THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+	(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+	OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+	Links
+	~~~~~
+	YouTube:	https://www.youtube.com/javidx9
+	Discord:	https://discord.gg/WhwHUMV
+	Twitter:	https://www.twitter.com/javidx9
+	Twitch:		https://www.twitch.tv/javidx9
+	GitHub:		https://www.github.com/onelonecoder
+	Homepage:	https://www.onelonecoder.com
+
+	Author
+	~~~~~~
+	David Barr, aka javidx9, ©OneLoneCoder 2019, 2020, 2021, 2022, 2023, 2024
+
+*/
+
+#define OLC_PGE_APPLICATION
+#include "olcPixelGameEngine.h"
+
+class Test_ResourcePack : public olc::PixelGameEngine
+{
+public:
+	Test_ResourcePack()
+	{
+		sAppName = "Test_ResourcePack";
+	}
+
+	int nResult = 0;
+
+protected:
+	const std::string sDir = "TEST_ResourcePack_files";
+	std::map<std::string, std::vector<uint8_t>> mapFiles;
+
+	void Check(const std::string& sWhat, bool bPass)
+	{
+		std::cout << (bPass ? "  pass  " : "  FAIL  ") << sWhat << "\n";
+		if (!bPass) nResult = 1;
+	}
+
+	void WriteFile(const std::string& sFile, const std::vector<uint8_t>& vData)
+	{
+		std::ofstream ofs(sFile, std::ofstream::binary);
+		ofs.write((const char*)vData.data(), std::streamsize(vData.size()));
+		mapFiles[sFile] = vData;
+	}
+
+	// Packs every test file, compressing those asked for
+	bool MakePack(const std::string& sPack, const std::string& sKey)
+	{
+		olc::ResourcePack pack;
+		bool bAdded = true;
+		for (const auto& f : mapFiles)
+			bAdded &= pack.AddFile(f.first, f.first.find("compressed") != std::string::npos);
+		return bAdded && pack.SavePack(sPack, sKey);
+	}
+
+	// Loads a pack and checks everything in it matches what went in
+	void TestPack(const std::string& sPack, const std::string& sKey)
+	{
+		const std::string sName = sKey.empty() ? "no key: " : "key: ";
+
+		olc::ResourcePack pack;
+		Check(sName + "LoadPack()", pack.LoadPack(sPack, sKey));
+		if (!pack.Loaded()) return;
+		Check(sName + "VerifyPack()", pack.VerifyPack());
+		Check(sName + "GetFileList() has every file", pack.GetFileList().size() == mapFiles.size());
+
+		for (const auto& f : mapFiles)
+		{
+			olc::ResourceView rv = pack.GetFileView(f.first);
+			Check(sName + f.first + " view matches",
+				rv.size() == f.second.size() && std::equal(f.second.begin(), f.second.end(), rv.data()));
+
+			olc::ResourceBuffer rb = pack.GetFileBuffer(f.first);
+			Check(sName + f.first + " buffer matches",
+				rb.vMemory.size() == f.second.size() && std::equal(f.second.begin(), f.second.end(), (const uint8_t*)rb.vMemory.data()));
+		}
+
+		Check(sName + "missing file is empty", pack.GetFileView(sDir + "/missing.bin").empty());
+	}
+
+	// Native images load from packs too, and a damaged one must fail to load
+	// rather than read past the end of its file
+	void TestNativeImages()
+	{
+		olc::Sprite spr(64, 64);
+		for (int y = 0; y < 64; y++)
+			for (int x = 0; x < 64; x++)
+				spr.SetPixel(x, y, olc::Pixel(uint8_t(x * 4), uint8_t(y * 4), uint8_t(x ^ y)));
+
+		const std::string sStored = sDir + "/native_stored.olcspr";
+		const std::string sCompressed = sDir + "/native_compressed.olcspr";
+		const std::string sBadCodec = sDir + "/native_badcodec.olcspr";
+		Check("native: SaveNativeImage() stored", olc::ImageLoader::SaveNativeImage(&spr, sStored) == olc::rcode::OK);
+		Check("native: SaveNativeImage() compressed", olc::ImageLoader::SaveNativeImage(&spr, sCompressed, false, true) == olc::rcode::OK);
+
+		// The codec follows the 8 byte magic, the version and the level count
+		_gfs::copy_file(sCompressed, sBadCodec, _gfs::copy_options::overwrite_existing);
+		{
+			std::fstream fs(sBadCodec, std::ios::in | std::ios::out | std::ios::binary);
+			const uint32_t nCodec = 7;
+			fs.seekp(16);
+			fs.write((const char*)&nCodec, sizeof(uint32_t));
+		}
+
+		const std::string sPack = sDir + "/native.dat";
+		olc::ResourcePack packOut;
+		packOut.AddFile(sStored);
+		packOut.AddFile(sCompressed);
+		packOut.AddFile(sBadCodec);
+		Check("native: SavePack()", packOut.SavePack(sPack, ""));
+
+		olc::ResourcePack pack;
+		Check("native: LoadPack()", pack.LoadPack(sPack, ""));
+		for (const auto& sFile : { sStored, sCompressed })
+		{
+			olc::Sprite sprLoaded;
+			Check("native: " + sFile + " loads from the pack",
+				sprLoaded.LoadFromFile(sFile, &pack) == olc::rcode::OK && sprLoaded.Size() == spr.Size()
+				&& std::equal(spr.pColData.begin(), spr.pColData.end(), sprLoaded.pColData.begin()));
+		}
+
+		olc::Sprite sprBad;
+		Check("native: unknown codec fails from the pack", sprBad.LoadFromFile(sBadCodec, &pack) != olc::rcode::OK);
+		Check("native: unknown codec fails from the file", sprBad.LoadFromFile(sBadCodec) != olc::rcode::OK);
+	}
+
+public:
+	bool OnUserCreate() override
+	{
+		_gfs::create_directories(sDir);
+
+		// Noise doesnt compress, so is stored even when asked
+		std::vector<uint8_t> vNoise(10000);
+		uint32_t nSeed = 0x12345678;
+		for (auto& b : vNoise)
+		{
+			nSeed = nSeed * 1664525 + 1013904223;
+			b = uint8_t(nSeed >> 24);
+		}
+		WriteFile(sDir + "/stored.bin", vNoise);
+
+		std::string sText;
+		for (int i = 0; i < 500; i++) sText += "The quick brown fox jumps over the lazy dog " + std::to_string(i % 7) + "\n";
+		WriteFile(sDir + "/compressed.txt", std::vector<uint8_t>(sText.begin(), sText.end()));
+
+		WriteFile(sDir + "/empty.bin", {});
+
+		// Spans a few pages, and compresses
+		std::vector<uint8_t> vBig(100000);
+		for (size_t i = 0; i < vBig.size(); i++) vBig[i] = uint8_t((i / 64) ^ (i % 13));
+		WriteFile(sDir + "/compressed_big.bin", vBig);
+
+		const std::string sPlain = sDir + "/plain.dat";
+		const std::string sKeyed = sDir + "/keyed.dat";
+		const std::string sKey = "OneLoneCoder";
+
+		std::cout << "ResourcePack round trip\n";
+		Check("SavePack() without a key", MakePack(sPlain, ""));
+		Check("SavePack() with a key", MakePack(sKeyed, sKey));
+		// Raw, the big file alone would fill more than this
+		Check("compressed files are packed smaller", _gfs::file_size(sPlain) < vBig.size());
+		TestPack(sPlain, "");
+		TestPack(sKeyed, sKey);
+
+		// The index checksum catches a wrong key
+		olc::ResourcePack packWrongKey;
+		Check("wrong key fails to load", !packWrongKey.LoadPack(sKeyed, "NotTheKey"));
+
+		// The index is at the end of the pack, so damage its last byte
+		const std::string sDamaged = sDir + "/damaged.dat";
+		_gfs::copy_file(sPlain, sDamaged, _gfs::copy_options::overwrite_existing);
+		{
+			std::fstream fs(sDamaged, std::ios::in | std::ios::out | std::ios::binary);
+			fs.seekg(-1, std::ios::end);
+			const char c = char(fs.get() ^ 0x5A);
+			fs.seekp(-1, std::ios::end);
+			fs.put(c);
+		}
+		olc::ResourcePack packDamaged;
+		Check("damaged index fails to load", !packDamaged.LoadPack(sDamaged, ""));
+
+		TestNativeImages();
+
+		_gfs::remove_all(sDir);
+		std::cout << (nResult == 0 ? "All passed\n" : "Some checks FAILED\n");
+		return false;
+	}
+
+	bool OnUserUpdate(float fElapsedTime) override
+	{
+		return false;
+	}
+};
+
+int main()
+{
+	Test_ResourcePack demo;
+	if (demo.Construct(256, 240, 2, 2))
+		demo.Start();
+	return demo.nResult;
+}
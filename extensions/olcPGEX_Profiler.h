@@ -0,0 +1,255 @@
+/*
+	olcPGEX_Profiler.h
+
+	+-------------------------------------------------------------+
+	|         OneLoneCoder Pixel Game Engine Extension            |
+	|                    Profiler Overlay v1.0                    |
+	+-------------------------------------------------------------+
+
+	What is this?
+	~~~~~~~~~~~~~
+	Draws what olc::Profiler recorded over the top of your application.
+	A graph of recent frame times shows spikes against a budget, and
+	below that is a breakdown of the zones in the last frame, and how
+	many decals and GPU tasks each layer drew.
+
+	The engine times its own phases, and you can time your own code too:
+
+		bool OnUserUpdate(float fElapsedTime) override
+		{
+			olc::Profiler::Scope zone(GetProfiler(), "Physics");
+			...
+		}
+
+	F3 shows and hides the overlay. Recording starts when the overlay is
+	made, and carries on while it is hidden, so call
+	GetProfiler().SaveChromeTrace("trace.json") whenever you like to look
+	at the last few seconds in chrome://tracing or Perfetto.
+
+	Example
+	~~~~~~~
+
+		#define OLC_PGE_APPLICATION
+		#include "olcPixelGameEngine.h"
+
+		#define OLC_PGEX_PROFILER
+		#include "extensions/olcPGEX_Profiler.h"
+
+		class Example : public olc::PixelGameEngine
+		{
+			olc::ProfilerOverlay overlay;
+			...
+		};
+
+
+	License (OLC-3)
+	~~~~~~~~~~~~~~~
+
+	Copyright 2018 - 2024 OneLoneCoder.com
+
+	Redistribution and use in source and binary forms, with or without
+	modification, are permitted provided that the following conditions
+	are met:
+
+	1. Redistributions or derivations of source code must retain the above
+	copyright notice, this list of conditions and the following disclaimer.
+
+	2. Redistributions or derivative works in binary form must reproduce
+	the above copyright notice. This list of conditions and the following
+	disclaimer must be reproduced in the documentation and/or other
+	materials provided with the distribution.
+
+	3. Neither the name of the copyright holder nor the names of its
+	contributors may be used to endorse or promote products derived
+	from this software without specific prior written permission.
+
+	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+	A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+	HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+	SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+	LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+	DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+	THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+	(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+	OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+	Links
+	~~~~~
+	YouTube:	https://www.youtube.com/javidx9
+	Discord:	https://discord.gg/WhwHUMV
+	Twitter:	https://www.twitter.com/javidx9
+	Twitch:		https://www.twitch.tv/javidx9
+	GitHub:		https://www.github.com/onelonecoder
+	Homepage:	https://www.onelonecoder.com
+
+	Author
+	~~~~~~
+	David Barr, aka javidx9, ©OneLoneCoder 2019, 2020, 2021, 2022, 2023, 2024
+
+	Revisions:
+	1.00:	Initial Release
+*/
+
+#pragma once
+
+#include "olcPixelGameEngine.h"
+
+namespace olc
+{
+	class ProfilerOverlay : public olc::PGEX
+	{
+	public:
+		ProfilerOverlay(const olc::Key kToggle = olc::Key::F3);
+
+		void Show(const bool bShow);
+		bool IsShown() const;
+		// Frames longer than this are drawn red in the graph, default is 60fps
+		void SetBudget(const float fSeconds);
+		void SetPosition(const olc::vf2d& vPos);
+
+	protected:
+		virtual void OnAfterUserCreate() override;
+		virtual void OnAfterUserUpdate(float fElapsedTime) override;
+
+	private:
+		// Zones with the same name and depth are added together, so the
+		// per layer zones read as one line
+		struct ZoneTotal
+		{
+			const char* sName = nullptr;
+			uint32_t nDepth = 0;
+			int64_t nTime = 0;
+		};
+
+		std::string Millis(const float fSeconds) const;
+
+		olc::Key kToggle;
+		olc::vf2d vPosition = { 4.0f, 4.0f };
+		float fBudget = 1.0f / 60.0f;
+		bool bShow = true;
+		std::vector<ZoneTotal> vTotals;
+	};
+}
+
+#ifdef OLC_PGEX_PROFILER
+#undef OLC_PGEX_PROFILER
+
+namespace olc
+{
+	ProfilerOverlay::ProfilerOverlay(const olc::Key kToggle) : olc::PGEX(true), kToggle(kToggle)
+	{
+	}
+
+	void ProfilerOverlay::Show(const bool bShow)
+	{
+		this->bShow = bShow;
+	}
+
+	bool ProfilerOverlay::IsShown() const
+	{
+		return bShow;
+	}
+
+	void ProfilerOverlay::SetBudget(const float fSeconds)
+	{
+		fBudget = std::max(fSeconds, 0.0001f);
+	}
+
+	void ProfilerOverlay::SetPosition(const olc::vf2d& vPos)
+	{
+		vPosition = vPos;
+	}
+
+	void ProfilerOverlay::OnAfterUserCreate()
+	{
+		pge->GetProfiler().Enable(true);
+	}
+
+	std::string ProfilerOverlay::Millis(const float fSeconds) const
+	{
+		std::stringstream ss;
+		ss << std::fixed << std::setprecision(2) << fSeconds * 1000.0f << "ms";
+		return ss.str();
+	}
+
+	void ProfilerOverlay::OnAfterUserUpdate(float fElapsedTime)
+	{
+		if (pge->GetKey(kToggle).bPressed) bShow = !bShow;
+
+		const olc::Profiler& profiler = pge->GetProfiler();
+		if (!bShow || profiler.GetFrameCount() == 0) return;
+
+		// Overlay goes on the top layer, drawn as decals so the layer itself
+		// is left alone. Whatever the user had selected is put back afterwards
+		olc::Sprite* pOldTarget = pge->GetDrawTarget();
+		const uint8_t nOldLayer = pge->GetDrawTargetLayer();
+		const olc::DecalMode nOldMode = pge->GetDecalMode();
+		pge->SetDrawTarget(nullptr);
+		pge->SetDecalMode(olc::DecalMode::NORMAL);
+
+		const olc::Profiler::Frame& frame = profiler.GetFrame(0);
+
+		// Add up the zones of the last frame
+		vTotals.clear();
+		for (const auto& zone : frame.vZones)
+		{
+			auto it = std::find_if(vTotals.begin(), vTotals.end(), [&zone](const ZoneTotal& t)
+				{ return t.nDepth == zone.nDepth && std::strcmp(t.sName, zone.sName) == 0; });
+			if (it == vTotals.end())
+				vTotals.push_back({ zone.sName, zone.nDepth, zone.nEnd - zone.nStart });
+			else
+				it->nTime += zone.nEnd - zone.nStart;
+		}
+
+		const int32_t nBars = int32_t(std::min(profiler.GetFrameCount(), size_t(160)));
+		const float fGraphHeight = 40.0f;
+		const float fWidth = std::max(float(nBars), 160.0f) + 8.0f;
+		const float fHeight = 8.0f + 10.0f + fGraphHeight + 4.0f + float(vTotals.size() + frame.vLayers.size()) * 10.0f + 4.0f;
+		pge->FillRectDecal(vPosition, { fWidth, fHeight }, olc::Pixel(0, 0, 0, 192));
+
+		olc::vf2d vCursor = vPosition + olc::vf2d(4.0f, 4.0f);
+
+		float fWorst = 0.0f;
+		for (int32_t i = 0; i < nBars; i++)
+			fWorst = std::max(fWorst, profiler.GetFrame(size_t(i)).Duration());
+		pge->DrawStringDecal(vCursor, "Frame " + Millis(frame.Duration()) + " Worst " + Millis(fWorst),
+			frame.Duration() > fBudget ? olc::RED : olc::WHITE);
+		vCursor.y += 10.0f;
+
+		// Graph the most recent frames right to left, the full height being
+		// twice the budget, and draw the budget across it
+		const float fScale = fGraphHeight / (fBudget * 2.0f);
+		for (int32_t i = 0; i < nBars; i++)
+		{
+			const float fTime = profiler.GetFrame(size_t(i)).Duration();
+			const float fBar = std::min(fTime * fScale, fGraphHeight);
+			pge->FillRectDecal({ vCursor.x + float(nBars - 1 - i), vCursor.y + fGraphHeight - fBar }, { 1.0f, fBar },
+				fTime > fBudget ? olc::RED : olc::GREEN);
+		}
+		pge->DrawLineDecal({ vCursor.x, vCursor.y + fGraphHeight * 0.5f }, { vCursor.x + float(nBars), vCursor.y + fGraphHeight * 0.5f }, olc::YELLOW);
+		vCursor.y += fGraphHeight + 4.0f;
+
+		for (const auto& total : vTotals)
+		{
+			pge->DrawStringDecal(vCursor + olc::vf2d(float(total.nDepth) * 8.0f, 0.0f),
+				std::string(total.sName) + " " + Millis(float(total.nTime) * 1e-9f), olc::GREY);
+			vCursor.y += 10.0f;
+		}
+
+		for (size_t i = 0; i < frame.vLayers.size(); i++)
+		{
+			pge->DrawStringDecal(vCursor, "Layer " + std::to_string(i) + ": " + std::to_string(frame.vLayers[i].nDecals)
+				+ " decals " + std::to_string(frame.vLayers[i].nGPUTasks) + " tasks", olc::CYAN);
+			vCursor.y += 10.0f;
+		}
+
+		// Selecting the layer again mustnt change whether it gets uploaded
+		pge->SetDrawTarget(nOldLayer, pge->GetLayers()[nOldLayer].bUpdate);
+		if (pOldTarget) pge->SetDrawTarget(pOldTarget);
+		pge->SetDecalMode(nOldMode);
+	}
+}
+
+#endif
@@ -776,13 +776,17 @@ namespace olc
 
 		SetSourceDecal(decal, 0);
 
+		olc::vf2d vPos[4], vUV[4];
+		float fW[4];
+		olc::Pixel pTint[4];
 		DecalInstance di;
+		di.pos = vPos; di.uv = vUV; di.w = fW; di.tint = pTint;
 		di.decal = decal;
 		di.points = 4;
-		di.tint = { tint, tint, tint, tint };
-		di.pos = { { vScreenSpacePos.x, vScreenSpacePos.y }, { vScreenSpacePos.x, vScreenSpaceDim.y }, { vScreenSpaceDim.x, vScreenSpaceDim.y }, { vScreenSpaceDim.x, vScreenSpacePos.y } };
-		di.uv = { { 0.0f, 0.0f}, {0.0f, 1.0f}, {1.0f, 1.0f}, {1.0f, 0.0f} };
-		di.w = { 1, 1, 1, 1 };
+		std::fill_n(di.tint, 4, tint);
+		vPos[0] = vScreenSpacePos; vPos[1] = { vScreenSpacePos.x, vScreenSpaceDim.y }; vPos[2] = vScreenSpaceDim; vPos[3] = { vScreenSpaceDim.x, vScreenSpacePos.y };
+		vUV[0] = { 0.0f, 0.0f }; vUV[1] = { 0.0f, 1.0f }; vUV[2] = { 1.0f, 1.0f }; vUV[3] = { 1.0f, 0.0f };
+		std::fill_n(di.w, 4, 1.0f);
 		Render(di);
 	}
 
@@ -802,15 +806,19 @@ namespace olc
 
 		SetSourceDecal(decal, 0);
 
+		olc::vf2d vPos[4], vUV[4];
+		float fW[4];
+		olc::Pixel pTint[4];
 		DecalInstance di;
+		di.pos = vPos; di.uv = vUV; di.w = fW; di.tint = pTint;
 		di.points = 4;
 		di.decal = decal;
-		di.tint = { tint, tint, tint, tint };
-		di.pos = { { vScreenSpacePos.x, vScreenSpacePos.y }, { vScreenSpacePos.x, vScreenSpaceDim.y }, { vScreenSpaceDim.x, vScreenSpaceDim.y }, { vScreenSpaceDim.x, vScreenSpacePos.y } };
+		std::fill_n(di.tint, 4, tint);
+		vPos[0] = vScreenSpacePos; vPos[1] = { vScreenSpacePos.x, vScreenSpaceDim.y }; vPos[2] = vScreenSpaceDim; vPos[3] = { vScreenSpaceDim.x, vScreenSpacePos.y };
 		olc::vf2d uvtl = source_pos * decal->vUVScale;
 		olc::vf2d uvbr = uvtl + (source_size * decal->vUVScale);
-		di.uv = { { uvtl.x, uvtl.y }, { uvtl.x, uvbr.y }, { uvbr.x, uvbr.y }, { uvbr.x, uvtl.y } };
-		di.w = { 1,1,1,1 };
+		vUV[0] = uvtl; vUV[1] = { uvtl.x, uvbr.y }; vUV[2] = uvbr; vUV[3] = { uvbr.x, uvtl.y };
+		std::fill_n(di.w, 4, 1.0f);
 		Render(di);
 	}
 
@@ -830,15 +838,19 @@ namespace olc
 
 		SetSourceDecal(decal, 0);
 
+		olc::vf2d vPos[4], vUV[4];
+		float fW[4];
+		olc::Pixel pTint[4];
 		DecalInstance di;
+		di.pos = vPos; di.uv = vUV; di.w = fW; di.tint = pTint;
 		di.points = 4;
 		di.decal = decal;
-		di.tint = { tint, tint, tint, tint };
-		di.pos = { { vScreenSpacePos.x, vScreenSpacePos.y }, { vScreenSpacePos.x, vScreenSpaceDim.y }, { vScreenSpaceDim.x, vScreenSpaceDim.y }, { vScreenSpaceDim.x, vScreenSpacePos.y } };
+		std::fill_n(di.tint, 4, tint);
+		vPos[0] = vScreenSpacePos; vPos[1] = { vScreenSpacePos.x, vScreenSpaceDim.y }; vPos[2] = vScreenSpaceDim; vPos[3] = { vScreenSpaceDim.x, vScreenSpacePos.y };
 		olc::vf2d uvtl = (source_pos)*decal->vUVScale;
 		olc::vf2d uvbr = uvtl + ((source_size)*decal->vUVScale);
-		di.uv = { { uvtl.x, uvtl.y }, { uvtl.x, uvbr.y }, { uvbr.x, uvbr.y }, { uvbr.x, uvtl.y } };
-		di.w = { 1,1,1,1 };
+		vUV[0] = uvtl; vUV[1] = { uvtl.x, uvbr.y }; vUV[2] = uvbr; vUV[3] = { uvbr.x, uvtl.y };
+		std::fill_n(di.w, 4, 1.0f);
 		Render(di);
 	}
 
@@ -297,7 +297,7 @@ namespace olc
 
 		if (pack != nullptr)
 		{			
-			olc::ResourceBuffer rb = pack->GetFileBuffer(sWavFile);
+			olc::ResourceViewBuffer rb(pack->GetFileView(sWavFile));
 			std::istream is(&rb);			
 			return ReadWave(is);
 		}
@@ -357,6 +357,66 @@
 		  Updated Geometry2D to support non-segment line intersections
 		  +olcUTIL_Hardware3D.h file v1.01
 		  NOTICE OF DEPRECATION! olc::DecalInstance is to be removed and replaced by olc::GPUTask
+	2.30: Software Rendering Performance
+		  Fill primitives write clipped horizontal spans directly into the draw target
+		  +PixelBlend() - Integer alpha blend of two pixels, bit-exact with...
+		  +PixelBlendSpan() - ...vectorised (SSE2/AVX2/NEON) blending of pixel runs
+		  FillRect() and Clear() work in whole rows
+		  DrawSprite() and DrawPartialSprite() pre-clip and blit whole rows
+		  FillTriangle() and FillTexturedTriangle() use a block based edge function rasteriser
+		  +FillTexturedTriangle() - Non-allocating overload taking arrays of 3 vertices
+		  +FillTexturedPolygon() - Non-allocating overload taking pointer + count
+		  +DrawPolygonDecal() - Non-allocating overloads taking pointer + count
+		  DrawCircle() draws the runs along each row as spans
+		  +DrawEllipse() - Draws an axis aligned ellipse outline
+		  +FillEllipse() - Fills an axis aligned ellipse
+		  DrawLine() steps a pointer through the draw target, solid lines skip the pattern
+		  +DrawLineAA() - Anti-aliased lines (Xiaolin Wu)
+		  +DrawLines() - Draws strips, lists or fans of lines in one call
+		  DrawString() and DrawStringProp() blit glyphs from 1 bit per pixel row masks
+		  OpenGL 3.3 renderer batches decals sharing a texture and mode into one draw, streamed
+		  through a ring buffer, which also lifts the 128 vertex limit on a single decal
+		  +Renderer::Flush() - Submits any batched drawing
+		  DecalInstance vertices live in a per layer arena that keeps its capacity between frames,
+		  DecalInstance::z is removed
+		  +DecalAtlas - Skyline packs sprites into shared pages, handing out decals that draw from them
+		  +DrawDecalInstanced() - Draws many transformed copies of a decal, expanded on the GPU by the
+		  OpenGL 3.3 renderer and on the CPU by the others
+		  +olc::InstanceData - Position, scale, rotation, source rect and tint of one instance
+		  Sprites track a dirty rectangle, and layers only upload that part of their texture
+		  +Sprite::MarkDirty(), GetDirtyRect(), ClearDirty() - For code writing pColData directly
+		  +Decal::UpdateDirty() - Uploads only the sprite's dirty rectangle
+		  +Renderer::UpdateTextureRegion() - Uploads part of a texture
+		  +Decal::UpdateAsync(), UpdateSpriteAsync(), IsTransferComplete() - Texture transfers that
+		  dont wait for the GPU, through fenced pixel buffers on OpenGL 3.3
+		  OpenGL 3.3 renderer caches GL state and skips calls that would not change it
+		  +GetRendererStats() - Draw calls and state changes made (and skipped) last frame
+		  +Renderer::InvalidateState() - Forget cached state after foreign GL code, eg layer hooks
+		  Frame timing uses std::chrono::steady_clock
+		  +SetFrameRateLimit() - Paces frames to a fixed rate, sleeping then spinning until each is due
+		  +adv_PipelinedFramesEnable() - [ADVANCED] Present each frame after simulating the next
+		  +Renderer::SubmitFrame() - Starts the GPU on a frame without presenting it
+		  +OnFixedUpdate() - Override is called at a fixed rate set by SetFixedUpdateRate()
+		  +GetFixedUpdateAlpha() - Blend factor between fixed updates for drawing
+		  +PGEX::OnBeforeFixedUpdate()/OnAfterFixedUpdate()
+		  +olc::Profiler - Scoped timing zones per frame, engine phases timed automatically
+		  +GetProfiler() - Access the engine's profiler, see also olcPGEX_Profiler.h
+		  +GetDrawTargetLayer(), GetDecalMode() - So extensions can put back what they change
+		  +Profiler::SaveChromeTrace() - Export recent frames for chrome://tracing
+		  +olc::AssetLoader - Decodes images on worker threads, turns them into decals within a per frame budget
+		  =ResourcePack::GetFileBuffer() is safe to call from several threads
+		  =ResourcePack memory maps the pack rather than streaming it
+		  +ResourcePack::GetFileView() - A file in the pack, in place, no copying
+		  +olc::ResourceViewBuffer - Streams a ResourceView for stream based loaders
+		  +ResourcePack version 2 - Hashed index, 64 bit offsets, page aligned files, checksums
+		  +ResourcePack::AddFile() can compress files (LZ4 block format)
+		  +ResourcePack::GetFileList(), ResourcePack::VerifyPack()
+		  +tools/respack - Command line packer
+		  +Native ".olcspr" images - Stored as the sprite holds them, loaded with no decoding, optional mips and compression
+		  +Sprite::SaveToFile()
+		  =Sprite::LoadFromFile() recognises native images, and works without an image loader
+		  +ImageLoader::SaveEncodedImage() - PNG, QOI and BMP encoders with no dependencies, all image loaders now save
+		  +AssetLoader::SaveSprite() - Saves a copy of a sprite on a worker thread
 
 
 	!! Apple Platforms will not see these updates immediately - Sorry, I dont have a mac to test... !!
@@ -424,6 +484,7 @@ int main()
 #include <iostream>
 #include <streambuf>
 #include <sstream>
+#include <iomanip>
 #include <chrono>
 #include <vector>
 #include <list>
@@ -435,9 +496,11 @@ int main()
 #include <algorithm>
 #include <array>
 #include <cstring>
+#include <mutex>
+#include <condition_variable>
 #pragma endregion
 
-#define PGE_VER 229
+#define PGE_VER 230
 
 // O------------------------------------------------------------------------------O
 // | COMPILER CONFIGURATION ODDITIES                                              |
@@ -540,6 +603,28 @@ namespace _gfs = std::filesystem;
 #endif
 #endif
 
+// Vector instructions for software blending, #define OLC_SIMD_NONE to disable
+#if !defined(OLC_SIMD_NONE) && !defined(OLC_SIMD_SSE2) && !defined(OLC_SIMD_NEON)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define OLC_SIMD_SSE2
+#if defined(__AVX2__)
+#define OLC_SIMD_AVX2
+#endif
+#endif
+#if defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#define OLC_SIMD_NEON
+#endif
+#endif
+
+#if defined(OLC_SIMD_AVX2)
+#include <immintrin.h>
+#elif defined(OLC_SIMD_SSE2)
+#include <emmintrin.h>
+#endif
+#if defined(OLC_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
 // File resolver for runtime FS access of emscripten builds
 #if defined(__EMSCRIPTEN__)
 #include <emscripten.h>
@@ -990,6 +1075,14 @@ namespace olc
 		MAGENTA(255, 0, 255), DARK_MAGENTA(128, 0, 128), VERY_DARK_MAGENTA(64, 0, 64),
 		WHITE(255, 255, 255), BLACK(0, 0, 0), BLANK(0, 0, 0, 0);
 #endif
+
+	// Alpha blends src over dst, nBlend additionally scales src alpha (255 = opaque).
+	// Result is always opaque, as with Pixel::ALPHA drawing
+	Pixel PixelBlend(const olc::Pixel& dst, const olc::Pixel& src, const uint8_t nBlend = 255);
+	// As above, in place over a run of pixels, vectorised where the CPU allows
+	void PixelBlendSpan(olc::Pixel* pDst, const olc::Pixel* pSrc, const size_t nCount, const uint8_t nBlend = 255);
+	void PixelBlendSpan(olc::Pixel* pDst, const olc::Pixel& src, const size_t nCount, const uint8_t nBlend = 255);
+
 	// Thanks to scripticuk and others for updating the key maps
 	// NOTE: The GLUT platform will need updating, open to contributions ;)
 	enum class Key : uint8_t
@@ -1029,26 +1122,118 @@ namespace olc
 	// O------------------------------------------------------------------------------O
 	// | olc::ResourcePack - A virtual scrambled filesystem to pack your assets into  |
 	// O------------------------------------------------------------------------------O
+	// A file inside a loaded ResourcePack, read straight from the pack's memory.
+	// Valid for as long as the pack stays loaded, and safe to read from any thread
+	struct ResourceView
+	{
+		const uint8_t* pData = nullptr;
+		size_t nSize = 0;
+
+		const uint8_t* data() const { return pData; }
+		size_t size() const { return nSize; }
+		bool empty() const { return nSize == 0; }
+	};
+
 	struct ResourceBuffer : public std::streambuf
 	{
 		ResourceBuffer(std::ifstream& ifs, uint32_t offset, uint32_t size);
+		ResourceBuffer(const ResourceView& view);
 		std::vector<char> vMemory;
 	};
 
+	// Like ResourceBuffer, for handing a file to stream based loaders, but
+	// reads the view in place rather than copying it
+	struct ResourceViewBuffer : public std::streambuf
+	{
+		ResourceViewBuffer(const ResourceView& view);
+	protected:
+		pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override;
+		pos_type seekpos(pos_type pos, std::ios_base::openmode which) override;
+	};
+
 	class ResourcePack : public std::streambuf
 	{
 	public:
 		ResourcePack();
 		~ResourcePack();
-		bool AddFile(const std::string& sFile);
+		// bCompress stores the file compressed, if that makes it smaller
+		bool AddFile(const std::string& sFile, const bool bCompress = false);
+		// Reads both the original packs and version 2 ones
 		bool LoadPack(const std::string& sFile, const std::string& sKey);
+		// Always writes version 2
 		bool SavePack(const std::string& sFile, const std::string& sKey);
 		ResourceBuffer GetFileBuffer(const std::string& sFile);
+		// Compressed files are unpacked and checked the first time they are
+		// viewed, and kept unpacked until the pack is unloaded
+		ResourceView GetFileView(const std::string& sFile) const;
+		// Names of the files in a loaded pack
+		std::vector<std::string> GetFileList() const;
+		// Checks every file against its checksum, original packs have none
+		bool VerifyPack() const;
 		bool Loaded();
+		// The pack's CRC32 and LZ4 block codec, for anything else that wants them
+		static uint32_t Checksum(const uint8_t* pData, size_t nSize);
+		static std::vector<uint8_t> Compress(const uint8_t* pData, size_t nSize);
+		static bool Decompress(const uint8_t* pSrc, size_t nSrcSize, uint8_t* pDst, size_t nDstSize);
 	private:
-		struct sResourceFile { uint32_t nSize; uint32_t nOffset; };
+		struct sResourceFile { uint64_t nSize; uint64_t nOffset; bool bCompress = false; };
 		std::map<std::string, sResourceFile> mapFiles;
-		std::ifstream baseFile;
+
+		// Version 2 packs are a header, then each file on its own page, then
+		// the index. The index is a table of entries, an open addressed hash
+		// table of slots pointing into it, and then the names
+		struct PackHeader
+		{
+			char sMagic[8];
+			uint32_t nVersion;
+			uint32_t nFlags;
+			uint64_t nEntries;
+			uint64_t nSlots;
+			uint64_t nIndexOffset;
+			uint64_t nIndexSize;
+			uint32_t nIndexChecksum;
+			uint32_t nAlignment;
+		};
+		struct PackEntry
+		{
+			uint64_t nHash;
+			uint64_t nOffset;
+			uint64_t nSize;
+			uint64_t nRawSize;
+			uint32_t nNameOffset;
+			uint32_t nNameLength;
+			uint32_t nChecksum;
+			uint32_t nCodec;
+		};
+		enum PackCodec : uint32_t { CODEC_NONE = 0, CODEC_LZ = 1 };
+		static constexpr uint32_t nPackVersion = 2;
+		static constexpr uint32_t nPackAlignment = 4096;
+		static constexpr uint32_t nPackFlagScrambled = 1;
+
+		bool LoadPackV2(const std::string& sKey);
+		const PackEntry* FindEntry(const std::string& sFile) const;
+		std::string EntryName(const PackEntry& e) const;
+		static uint64_t HashName(const std::string& sName);
+
+		std::vector<char> vIndex;
+		const PackEntry* pEntries = nullptr;
+		const uint32_t* pSlots = nullptr;
+		const char* pNames = nullptr;
+		uint64_t nEntries = 0;
+		uint64_t nSlots = 0;
+		size_t nNamesSize = 0;
+		// Unpacked compressed files, by entry
+		mutable std::map<uint64_t, std::vector<uint8_t>> mapUnpacked;
+		mutable std::mutex muxUnpacked;
+		// A loaded pack is memory mapped where the platform allows, and read
+		// into vPackData where it doesn't
+		bool MapPack(const std::string& sFile);
+		void UnmapPack();
+		const uint8_t* pPackData = nullptr;
+		size_t nPackSize = 0;
+		std::vector<uint8_t> vPackData;
+		void* hPackFile = nullptr;
+		void* hPackMapping = nullptr;
 		std::vector<char> scramble(const std::vector<char>& data, const std::string& key);
 		std::string makeposix(const std::string& path);
 	};
@@ -1061,6 +1246,53 @@ namespace olc
 		virtual ~ImageLoader() = default;
 		virtual olc::rcode LoadImageResource(olc::Sprite* spr, const std::string& sImageFile, olc::ResourcePack* pack) = 0;
 		virtual olc::rcode SaveImageResource(olc::Sprite* spr, const std::string& sImageFile) = 0;
+
+	public:
+		// The engine's own image format, ".olcspr". The pixels are stored exactly as
+		// olc::Sprite holds them, so loading is a read straight into the sprite with
+		// no decoding. Optionally it holds a chain of mip levels, each half the size
+		// of the last, and optionally the levels are compressed. Sprite::LoadFromFile()
+		// recognises these files whatever they are called, and Sprite::SaveToFile()
+		// writes one when given a ".olcspr" name
+		static bool IsNativeImage(const std::string& sImageFile, olc::ResourcePack* pack = nullptr);
+		static olc::rcode LoadNativeImage(olc::Sprite* spr, const std::string& sImageFile, olc::ResourcePack* pack = nullptr, uint32_t nLevel = 0);
+		static olc::rcode SaveNativeImage(const olc::Sprite* spr, const std::string& sImageFile, bool bMipMaps = false, bool bCompress = false);
+		// Number of levels stored in a native image, 0 if it isn't one
+		static uint32_t GetNativeLevels(const std::string& sImageFile, olc::ResourcePack* pack = nullptr);
+
+		// Encoders that need no libraries, so every loader can save. The format comes
+		// from the extension, ".png", ".qoi" or ".bmp". QOI is the quickest by far, so
+		// use it for dumping lots of frames, and PNG for anything else. These only read
+		// the sprite, so they can run on any thread while nothing draws to it, or on a
+		// copy, see AssetLoader::SaveSprite()
+		static olc::rcode SaveEncodedImage(const olc::Sprite* spr, const std::string& sImageFile);
+		static std::vector<uint8_t> EncodePNG(const olc::Sprite* spr);
+		static std::vector<uint8_t> EncodeQOI(const olc::Sprite* spr);
+		static std::vector<uint8_t> EncodeBMP(const olc::Sprite* spr);
+
+	private:
+		static constexpr uint32_t nNativeVersion = 1;
+		static constexpr uint32_t nNativeMaxLevels = 16;
+		static constexpr uint32_t nNativeCodecLZ = 1;
+		struct NativeLevel
+		{
+			uint32_t nWidth;
+			uint32_t nHeight;
+			uint64_t nOffset;
+			// Stored size, which is the raw size unless the level is compressed
+			uint64_t nSize;
+		};
+		struct NativeHeader
+		{
+			char sMagic[8];
+			uint32_t nVersion;
+			uint32_t nLevels;
+			uint32_t nCodec;
+			uint32_t nReserved;
+			NativeLevel level[nNativeMaxLevels];
+		};
+		static bool ReadNativeHeader(const std::string& sImageFile, olc::ResourcePack* pack, NativeHeader& header, uint64_t& nFileSize);
+		static std::vector<uint8_t> Deflate(const uint8_t* pData, size_t nSize);
 	};
 
 
@@ -1078,6 +1310,10 @@ namespace olc
 
 	public:
 		olc::rcode LoadFromFile(const std::string& sImageFile, olc::ResourcePack* pack = nullptr);
+		// ".olcspr" files are written in the engine's own format, and ".png", ".qoi"
+		// and ".bmp" by the built in encoders, even without an image loader. Anything
+		// else is up to the image loader
+		olc::rcode SaveToFile(const std::string& sImageFile);
 
 	public:
 		int32_t width = 0;
@@ -1095,13 +1331,26 @@ namespace olc
 		Pixel Sample(const olc::vf2d& uv) const;
 		Pixel SampleBL(float u, float v) const;
 		Pixel SampleBL(const olc::vf2d& uv) const;
+		// Assumes the caller writes through the pointer, so marks the whole sprite dirty
 		Pixel* GetData();
 		olc::Sprite* Duplicate();
 		olc::Sprite* Duplicate(const olc::vi2d& vPos, const olc::vi2d& vSize);
 		olc::vi2d Size() const;
 		void SetSize(int32_t w, int32_t h);
+		// The dirty rectangle bounds pixels changed since the last ClearDirty(), so
+		// Decal::UpdateDirty() only uploads that part. Anything writing pColData directly marks it
+		void MarkDirty();
+		void MarkDirty(int32_t x1, int32_t y1, int32_t x2, int32_t y2);
+		bool GetDirtyRect(olc::vi2d& vPos, olc::vi2d& vSize) const;
+		void ClearDirty();
 		std::vector<olc::Pixel> pColData;
 		Mode modeSample = Mode::NORMAL;
+		// Inclusive corners, not clipped to the sprite until read
+		olc::vi2d vDirtyMin = { INT32_MAX, INT32_MAX };
+		olc::vi2d vDirtyMax = { INT32_MIN, INT32_MIN };
+		// Counts ClearDirty() calls, so a decal can tell if something else took the
+		// dirty rectangle since its texture last matched the sprite
+		uint32_t nDirtyEpoch = 0;
 
 		static std::unique_ptr<olc::ImageLoader> loader;
 	};
@@ -1116,12 +1365,33 @@ namespace olc
 		Decal(const uint32_t nExistingTextureResource, olc::Sprite* spr);
 		virtual ~Decal();
 		void Update();
+		// As Update(), but only sends the sprite's dirty rectangle, then clears it. If
+		// another decal of the same sprite cleared it first, everything is sent
+		void UpdateDirty();
 		void UpdateSprite();
+		// As above, but without waiting for the GPU. The sprite is copied out before
+		// UpdateAsync() returns. UpdateSpriteAsync() writes the sprite later, when
+		// IsTransferComplete() first returns true, so keep it alive until then
+		void UpdateAsync();
+		void UpdateSpriteAsync();
+		bool IsTransferComplete();
 
 	public: // But dont touch
 		int32_t id = -1;
 		olc::Sprite* sprite = nullptr;
 		olc::vf2d vUVScale = { 1.0f, 1.0f };
+		// The part of the texture this decal covers, which is all of it unless
+		// the decal came from a DecalAtlas, in which case the texture is shared
+		olc::vf2d vUVOffset = { 0.0f, 0.0f };
+		olc::vf2d vUVExtent = { 1.0f, 1.0f };
+		bool bShared = false;
+		// Size of the sprite when the texture was last fully uploaded
+		olc::vi2d vTextureSize = { 0, 0 };
+		// The sprite's nDirtyEpoch when the texture last matched it
+		uint32_t nDirtyEpoch = 0;
+		// Renderer ticket of the last asynchronous transfer, 0 once it is complete
+		uint32_t nTransfer = 0;
+		bool bTransferRead = false;
 	};
 
 	enum class DecalMode
@@ -1163,25 +1433,249 @@ namespace olc
 		std::unique_ptr<olc::Decal> pDecal = nullptr;
 	};
 
+	// O------------------------------------------------------------------------------O
+	// | olc::DecalAtlas - Packs many sprites into a few large shared textures        |
+	// O------------------------------------------------------------------------------O
+	class DecalAtlas
+	{
+	public:
+		DecalAtlas(uint32_t nPageWidth = 1024, uint32_t nPageHeight = 1024, bool filter = false);
+		DecalAtlas(const DecalAtlas&) = delete;
+		DecalAtlas& operator=(const DecalAtlas&) = delete;
+		// Copies the sprite into a page and returns a decal that draws it from there,
+		// or nullptr if it is larger than a page. The atlas owns the returned decal,
+		// and the sprite must outlive it. Call Update() before drawing
+		olc::Decal* Add(olc::Sprite* sprite);
+		// Copies the sprite behind an atlas decal into its page again
+		void Refresh(olc::Decal* decal);
+		// Uploads any pages that have changed
+		void Update();
+		size_t GetPageCount() const;
+		olc::Decal* GetPage(size_t nPage) const;
+
+	private:
+		// Skyline packing, each node is a run of the page's top edge at height y
+		struct SkylineNode { int32_t x, y, w; };
+		struct Page
+		{
+			olc::Renderable rPage;
+			std::vector<SkylineNode> vSkyline;
+			bool bDirty = false;
+		};
+		struct Region
+		{
+			std::unique_ptr<olc::Decal> pDecal;
+			size_t nPage = 0;
+			olc::vi2d vPos;
+		};
+
+		bool Pack(Page& page, int32_t w, int32_t h, olc::vi2d& vPos);
+		void Blit(const Region& region);
+
+		olc::vi2d vPageSize;
+		bool bFilter = false;
+		std::vector<std::unique_ptr<Page>> vPages;
+		std::vector<Region> vRegions;
+	};
+
+	// O------------------------------------------------------------------------------O
+	// | olc::Profiler - Times named zones within each frame                          |
+	// O------------------------------------------------------------------------------O
+	class Profiler
+	{
+	public:
+		struct Zone
+		{
+			const char* sName = nullptr;
+			uint32_t nDepth = 0;
+			// Nanoseconds since the profiler was made
+			int64_t nStart = 0;
+			int64_t nEnd = 0;
+		};
+
+		struct LayerCount
+		{
+			uint32_t nDecals = 0;
+			uint32_t nGPUTasks = 0;
+		};
+
+		struct Frame
+		{
+			uint64_t nFrame = 0;
+			int64_t nStart = 0;
+			int64_t nEnd = 0;
+			std::vector<Zone> vZones;
+			std::vector<LayerCount> vLayers;
+			// Length of the frame in seconds
+			float Duration() const;
+		};
+
+		// Times the rest of the enclosing block as a zone
+		class Scope
+		{
+		public:
+			Scope(olc::Profiler& profiler, const char* sName);
+			~Scope();
+			Scope(const Scope&) = delete;
+			Scope& operator=(const Scope&) = delete;
+		private:
+			olc::Profiler& profiler;
+		};
+
+	public:
+		Profiler(size_t nHistory = 240);
+		// Nothing is recorded while disabled, which it is to start with
+		void Enable(const bool bEnable);
+		bool IsEnabled() const;
+		// The engine brackets each frame with these
+		void BeginFrame();
+		void EndFrame();
+		// Zones nest, and sName is kept as is, so it must last, string literals are ideal
+		void BeginZone(const char* sName);
+		void EndZone();
+		void CountLayer(size_t nLayer, uint32_t nDecals, uint32_t nGPUTasks);
+		// Number of complete frames held, nAgo = 0 is the most recent
+		size_t GetFrameCount() const;
+		const Frame& GetFrame(size_t nAgo) const;
+		// Writes the held frames as Chrome trace events, for chrome://tracing or Perfetto
+		bool SaveChromeTrace(const std::string& sFile) const;
+
+	private:
+		int64_t Now() const;
+
+		// Ring of frames, the one at nHead being recorded
+		std::vector<Frame> vFrames;
+		size_t nHead = 0;
+		size_t nComplete = 0;
+		uint64_t nFrameCount = 0;
+		std::vector<size_t> vOpenZones;
+		bool bEnabled = false;
+		bool bInFrame = false;
+		std::chrono::time_point<std::chrono::steady_clock> tpEpoch;
+	};
+
+	// O------------------------------------------------------------------------------O
+	// | olc::AssetLoader - Decodes images on worker threads, uploads them in bits    |
+	// O------------------------------------------------------------------------------O
+	class AssetLoader
+	{
+	public:
+		enum class State { QUEUED, DECODING, UPLOADING, READY, FAILED };
+
+		// What a load request hands back. Poll it, the sprite and decal are
+		// only there once it is READY
+		class Asset
+		{
+		public:
+			State GetState() const;
+			bool IsReady() const;
+			bool IsFailed() const;
+			olc::rcode GetResult() const;
+			olc::Sprite* Sprite() const;
+			olc::Decal* Decal() const;
+
+		private:
+			friend class olc::AssetLoader;
+			std::string sFile;
+			olc::ResourcePack* pack = nullptr;
+			bool bSave = false;
+			bool bDecal = false;
+			bool bFilter = false;
+			bool bClamp = true;
+			std::atomic<State> nState{ State::QUEUED };
+			olc::rcode nResult = olc::rcode::OK;
+			std::unique_ptr<olc::Sprite> pSprite;
+			std::unique_ptr<olc::Decal> pDecal;
+		};
+		using Handle = std::shared_ptr<Asset>;
+
+	public:
+		// 0 threads = one fewer than the hardware has, leaving one for the engine
+		AssetLoader(uint32_t nThreads = 0);
+		~AssetLoader();
+		AssetLoader(const AssetLoader&) = delete;
+		AssetLoader& operator=(const AssetLoader&) = delete;
+
+		// Queues an image to be decoded into a sprite only
+		Handle LoadSprite(const std::string& sFile, olc::ResourcePack* pack = nullptr);
+		// Queues an image to be decoded, then turned into a decal by Update()
+		Handle LoadRenderable(const std::string& sFile, olc::ResourcePack* pack = nullptr, bool filter = false, bool clamp = true);
+		// Copies the sprite, then saves the copy as Sprite::SaveToFile() would, so
+		// the sprite can be drawn to again straight away. Good for screenshots
+		// and capturing frames without stalling
+		Handle SaveSprite(const olc::Sprite* spr, const std::string& sFile);
+		// Call from the engine thread each frame. Creates decals for decoded
+		// images until fBudget seconds have gone, always at least one
+		void Update(const float fBudget = 0.002f);
+		// Blocks until everything queued is READY or FAILED, engine thread only
+		void Wait();
+		// Number of requests not yet READY or FAILED
+		size_t GetPending() const;
+
+	private:
+		Handle Queue(Handle asset);
+		void Worker();
+		bool UploadNext();
+		void Finish(Asset& asset, const State nState);
+
+		std::vector<std::thread> vWorkers;
+		std::list<Handle> listDecode;
+		std::vector<Handle> vUpload;
+		std::mutex muxQueue;
+		std::condition_variable cvDecode, cvUpload;
+		std::atomic<size_t> nPending{ 0 };
+		bool bQuit = false;
+	};
+
 
 	// O------------------------------------------------------------------------------O
 	// | Auxilliary components internal to engine                                     |
 	// O------------------------------------------------------------------------------O
 
+	// One copy of a decal drawn by DrawDecalInstanced(). Sizes are in pixels of
+	// the source sprite, and a source_size of {0,0} means the whole decal
+	struct InstanceData
+	{
+		olc::vf2d pos = { 0.0f, 0.0f };
+		olc::vf2d scale = { 1.0f, 1.0f };
+		float fAngle = 0.0f;
+		olc::vf2d center = { 0.0f, 0.0f };
+		olc::vf2d source_pos = { 0.0f, 0.0f };
+		olc::vf2d source_size = { 0.0f, 0.0f };
+		olc::Pixel tint = olc::WHITE;
+	};
+
 	struct DecalInstance
 	{
 		olc::Decal* decal = nullptr;
-		std::vector<olc::vf2d> pos;
-		std::vector<olc::vf2d> uv;
-		std::vector<float> w;
-		std::vector<float> z;
-		std::vector<olc::Pixel> tint;
+		// Vertices live in the owning layer's DecalVertexArena, starting at
+		// offset. The pointers are (re)bound just before the renderer sees them
+		olc::vf2d* pos = nullptr;
+		olc::vf2d* uv = nullptr;
+		float* w = nullptr;
+		olc::Pixel* tint = nullptr;
+		uint32_t offset = 0;
+		// Set instead of the vertices above by DrawDecalInstanced()
+		olc::InstanceData* instances = nullptr;
+		uint32_t instanceOffset = 0;
+		uint32_t instanceCount = 0;
 		olc::DecalMode mode = olc::DecalMode::NORMAL;
 		olc::DecalStructure structure = olc::DecalStructure::FAN;
 		uint32_t points = 0;
 		bool depth = false;
 	};
 
+	// Vertex storage for all decals drawn to a layer in one frame. It is
+	// emptied once the layer is drawn, but keeps its capacity
+	struct DecalVertexArena
+	{
+		std::vector<olc::vf2d> pos;
+		std::vector<olc::vf2d> uv;
+		std::vector<float> w;
+		std::vector<olc::Pixel> tint;
+		std::vector<olc::InstanceData> instances;
+	};
+
 	enum class CullMode : uint8_t
 	{
 		NONE = 0,
@@ -1217,11 +1711,21 @@ namespace olc
 		olc::Renderable pDrawTarget;
 		uint32_t nResID = 0;
 		std::vector<DecalInstance> vecDecalInstance;
+		DecalVertexArena decalVerts;
 		std::vector<GPUTask> vecGPUTasks;
 		olc::Pixel tint = olc::WHITE;
 		std::function<void()> funcHook = nullptr;
 	};
 
+	// What the renderer sent to the graphics API over the last frame
+	struct RendererStats
+	{
+		uint32_t nDrawCalls = 0;
+		// State changes made, and those dropped as they would have changed nothing
+		uint32_t nStateCalls = 0;
+		uint32_t nStateCallsSkipped = 0;
+	};
+
 	class Renderer
 	{
 	public:
@@ -1234,15 +1738,33 @@ namespace olc
 		virtual void	   SetDecalMode(const olc::DecalMode& mode) = 0;
 		virtual void       DrawLayerQuad(const olc::vf2d& offset, const olc::vf2d& scale, const olc::Pixel tint) = 0;
 		virtual void       DrawDecal(const olc::DecalInstance& decal) = 0;
+		// By default each instance is expanded into a quad and passed to DrawDecal().
+		// vInvScreen is the reciprocal of the screen size, used to map pixels to NDC
+		virtual void       DrawDecalInstanced(const olc::DecalInstance& decal, const olc::vf2d& vInvScreen);
 		virtual void       DoGPUTask(const olc::GPUTask& task) = 0;
 		virtual void	   Set3DProjection(const std::array<float, 16>& mat) = 0;
 		virtual uint32_t   CreateTexture(const uint32_t width, const uint32_t height, const bool filtered = false, const bool clamp = true) = 0;
 		virtual void       UpdateTexture(uint32_t id, olc::Sprite* spr) = 0;
+		// Uploads just a rectangle of the sprite, by default the whole thing
+		virtual void       UpdateTextureRegion(uint32_t id, olc::Sprite* spr, const olc::vi2d&, const olc::vi2d&) { UpdateTexture(id, spr); }
 		virtual void       ReadTexture(uint32_t id, olc::Sprite* spr) = 0;
+		// Asynchronous transfers return a ticket for TransferComplete(), or 0 if they
+		// finished straight away, which is what renderers without them do
+		virtual uint32_t   UpdateTextureAsync(uint32_t id, olc::Sprite* spr) { UpdateTexture(id, spr); return 0; }
+		virtual uint32_t   ReadTextureAsync(uint32_t id, olc::Sprite* spr) { ReadTexture(id, spr); return 0; }
+		// Completed reads are copied into their sprite here. bWait blocks until done
+		virtual bool       TransferComplete(uint32_t nTicket, bool bWait = false) { UNUSED(nTicket); UNUSED(bWait); return true; }
 		virtual uint32_t   DeleteTexture(const uint32_t id) = 0;
 		virtual void       ApplyTexture(uint32_t id) = 0;
 		virtual void       UpdateViewport(const olc::vi2d& pos, const olc::vi2d& size) = 0;
 		virtual void       ClearBuffer(olc::Pixel p, bool bDepth) = 0;
+		// Renderers that batch decals submit whatever is pending here
+		virtual void       Flush() {}
+		// Starts the GPU on the frame so far without presenting it
+		virtual void       SubmitFrame() { Flush(); }
+		// Renderers that cache API state forget it here, as something else may have changed it
+		virtual void       InvalidateState() {}
+		virtual olc::RendererStats GetStats() const { return {}; }
 		static olc::PixelGameEngine* ptrPGE;
 	};
 
@@ -1289,6 +1811,9 @@ namespace olc
 		virtual bool OnUserCreate();
 		// Called every frame, and provides you with a time per frame value
 		virtual bool OnUserUpdate(float fElapsedTime);
+		// Called zero or more times per frame at the rate given to SetFixedUpdateRate(),
+		// always with the same time step, for simulation that must be repeatable
+		virtual bool OnFixedUpdate(float fFixedTime);
 		// Called once on application termination, so you can be one clean coder
 		virtual bool OnUserDestroy();
 
@@ -1333,6 +1858,8 @@ namespace olc
 		int32_t GetDrawTargetHeight() const;
 		// Returns the currently active draw target
 		olc::Sprite* GetDrawTarget() const;
+		// Returns the layer decals are currently drawn to
+		uint8_t GetDrawTargetLayer() const;
 		// Resize the primary screen sprite
 		void SetScreenSize(int w, int h);
 		// Specify which Sprite should be the target of drawing functions, use nullptr
@@ -1340,8 +1867,25 @@ namespace olc
 		void SetDrawTarget(Sprite* target);
 		// Gets the current Frames Per Second
 		uint32_t GetFPS() const;
+		// Gets counts of draw and state calls the renderer made last frame
+		olc::RendererStats GetRendererStats() const;
+		// Gets the frame profiler, which must be enabled before it records anything
+		olc::Profiler& GetProfiler();
 		// Gets last update of elapsed time
 		float GetElapsedTime() const;
+		// Holds the frame rate at or below fFramesPerSecond, sleeping then spinning
+		// until each frame is due. 0 = unlimited, vsync permitting. Emscripten builds
+		// have the browser's main loop run at this rate instead
+		void SetFrameRateLimit(const float fFramesPerSecond);
+		float GetFrameRateLimit() const;
+		// Calls OnFixedUpdate() fUpdatesPerSecond times a second before each OnUserUpdate(),
+		// running at most nMaxStepsPerFrame in any one frame and dropping the rest if it
+		// falls behind. 0 = off
+		void SetFixedUpdateRate(const float fUpdatesPerSecond, const uint32_t nMaxStepsPerFrame = 8);
+		float GetFixedUpdateRate() const;
+		// How far between the last fixed update and the next one this frame is, 0.0 to 1.0,
+		// for blending simulated states when drawing
+		float GetFixedUpdateAlpha() const;
 		// Gets Actual Window size
 		const olc::vi2d& GetWindowSize() const;
 		// Gets Actual Window position
@@ -1388,6 +1932,10 @@ namespace olc
 		void adv_FlushLayer(const size_t nLayerID);
 		void adv_FlushLayerDecals(const size_t nLayerID);
 		void adv_FlushLayerGPUTasks(const size_t nLayerID);
+		// Presents each frame only after the next has been simulated, so the GPU
+		// draws one frame while OnUserUpdate() works on the next. Adds a frame
+		// of latency, and has no effect while rendering manually
+		void adv_PipelinedFramesEnable(const bool bEnable);
 
 	public: // DRAWING ROUTINES
 		// Draws a single Pixel
@@ -1396,12 +1944,25 @@ namespace olc
 		// Draws a line from (x1,y1) to (x2,y2)
 		void DrawLine(int32_t x1, int32_t y1, int32_t x2, int32_t y2, Pixel p = olc::WHITE, uint32_t pattern = 0xFFFFFFFF);
 		void DrawLine(const olc::vi2d& pos1, const olc::vi2d& pos2, Pixel p = olc::WHITE, uint32_t pattern = 0xFFFFFFFF);
+		// Draws an anti-aliased line from pos1 to pos2, always alpha blended
+		void DrawLineAA(const olc::vf2d& pos1, const olc::vf2d& pos2, Pixel p = olc::WHITE);
+		// Draws many lines in one go. STRIP joins consecutive points, LIST (or LINE) draws
+		// pairs of points, and FAN joins every point to the first. The pattern carries on
+		// from one line to the next, and joined points are only drawn once
+		void DrawLines(const olc::vi2d* pPoints, size_t nPoints, Pixel p = olc::WHITE, uint32_t pattern = 0xFFFFFFFF, olc::DecalStructure structure = olc::DecalStructure::STRIP);
+		void DrawLines(const std::vector<olc::vi2d>& vPoints, Pixel p = olc::WHITE, uint32_t pattern = 0xFFFFFFFF, olc::DecalStructure structure = olc::DecalStructure::STRIP);
 		// Draws a circle located at (x,y) with radius
 		void DrawCircle(int32_t x, int32_t y, int32_t radius, Pixel p = olc::WHITE, uint8_t mask = 0xFF);
 		void DrawCircle(const olc::vi2d& pos, int32_t radius, Pixel p = olc::WHITE, uint8_t mask = 0xFF);
 		// Fills a circle located at (x,y) with radius
 		void FillCircle(int32_t x, int32_t y, int32_t radius, Pixel p = olc::WHITE);
 		void FillCircle(const olc::vi2d& pos, int32_t radius, Pixel p = olc::WHITE);
+		// Draws an ellipse located at (x,y) with radii rx and ry
+		void DrawEllipse(int32_t x, int32_t y, int32_t rx, int32_t ry, Pixel p = olc::WHITE);
+		void DrawEllipse(const olc::vi2d& pos, const olc::vi2d& radius, Pixel p = olc::WHITE);
+		// Fills an ellipse located at (x,y) with radii rx and ry
+		void FillEllipse(int32_t x, int32_t y, int32_t rx, int32_t ry, Pixel p = olc::WHITE);
+		void FillEllipse(const olc::vi2d& pos, const olc::vi2d& radius, Pixel p = olc::WHITE);
 		// Draws a rectangle at (x,y) to (x+w,y+h)
 		void DrawRect(int32_t x, int32_t y, int32_t w, int32_t h, Pixel p = olc::WHITE);
 		void DrawRect(const olc::vi2d& pos, const olc::vi2d& size, Pixel p = olc::WHITE);
@@ -1415,8 +1976,12 @@ namespace olc
 		void FillTriangle(int32_t x1, int32_t y1, int32_t x2, int32_t y2, int32_t x3, int32_t y3, Pixel p = olc::WHITE);
 		void FillTriangle(const olc::vi2d& pos1, const olc::vi2d& pos2, const olc::vi2d& pos3, Pixel p = olc::WHITE);
 		// Fill a textured and coloured triangle
-		void FillTexturedTriangle(std::vector<olc::vf2d> vPoints, std::vector<olc::vf2d> vTex, std::vector<olc::Pixel> vColour, olc::Sprite* sprTex);
+		void FillTexturedTriangle(const std::vector<olc::vf2d>& vPoints, const std::vector<olc::vf2d>& vTex, const std::vector<olc::Pixel>& vColour, olc::Sprite* sprTex);
+		// As above, but takes pointers to 3 points, texture coordinates and colours
+		void FillTexturedTriangle(const olc::vf2d* pPoints, const olc::vf2d* pTex, const olc::Pixel* pColour, olc::Sprite* sprTex);
 		void FillTexturedPolygon(const std::vector<olc::vf2d>& vPoints, const std::vector<olc::vf2d>& vTex, const std::vector<olc::Pixel>& vColour, olc::Sprite* sprTex, olc::DecalStructure structure = olc::DecalStructure::LIST);
+		// As above, but takes pointers to arrays of "elements" points, texture coordinates and colours
+		void FillTexturedPolygon(const olc::vf2d* pPoints, const olc::vf2d* pTex, const olc::Pixel* pColour, uint32_t elements, olc::Sprite* sprTex, olc::DecalStructure structure = olc::DecalStructure::LIST);
 		// Draws an entire sprite at location (x,y)
 		void DrawSprite(int32_t x, int32_t y, Sprite* sprite, uint32_t scale = 1, uint8_t flip = olc::Sprite::NONE);
 		void DrawSprite(const olc::vi2d& pos, Sprite* sprite, uint32_t scale = 1, uint8_t flip = olc::Sprite::NONE);
@@ -1436,6 +2001,7 @@ namespace olc
 		// Decal Quad functions
 		void SetDecalMode(const olc::DecalMode& mode);
 		void SetDecalStructure(const olc::DecalStructure& structure);
+		olc::DecalMode GetDecalMode() const;
 		// Draws a whole decal, with optional scale and tinting
 		void DrawDecal(const olc::vf2d& pos, olc::Decal* decal, const olc::vf2d& scale = { 1.0f,1.0f }, const olc::Pixel& tint = olc::WHITE);
 		// Draws a region of a decal, with optional scale and tinting
@@ -1454,6 +2020,9 @@ namespace olc
 		// Draws a decal rotated to specified angle, wit point of rotation offset
 		void DrawRotatedDecal(const olc::vf2d& pos, olc::Decal* decal, const float fAngle, const olc::vf2d& center = { 0.0f, 0.0f }, const olc::vf2d& scale = { 1.0f,1.0f }, const olc::Pixel& tint = olc::WHITE);
 		void DrawPartialRotatedDecal(const olc::vf2d& pos, olc::Decal* decal, const float fAngle, const olc::vf2d& center, const olc::vf2d& source_pos, const olc::vf2d& source_size, const olc::vf2d& scale = { 1.0f, 1.0f }, const olc::Pixel& tint = olc::WHITE);
+		// Draws many positioned, scaled, rotated and tinted copies of (part of) a decal at once
+		void DrawDecalInstanced(olc::Decal* decal, const olc::InstanceData* data, uint32_t count);
+		void DrawDecalInstanced(olc::Decal* decal, const std::vector<olc::InstanceData>& data);
 		// Draws a multiline string as a decal, with tiniting and scaling
 		void DrawStringDecal(const olc::vf2d& pos, const std::string& sText, const Pixel col = olc::WHITE, const olc::vf2d& scale = { 1.0f, 1.0f });
 		void DrawStringPropDecal(const olc::vf2d& pos, const std::string& sText, const Pixel col = olc::WHITE, const olc::vf2d& scale = { 1.0f, 1.0f });
@@ -1472,12 +2041,15 @@ namespace olc
 		void DrawPolygonDecal(olc::Decal* decal, const std::vector<olc::vf2d>& pos, const std::vector<olc::vf2d>& uv, const std::vector<olc::Pixel>& tint);
 		void DrawPolygonDecal(olc::Decal* decal, const std::vector<olc::vf2d>& pos, const std::vector<olc::vf2d>& uv, const std::vector<olc::Pixel>& colours, const olc::Pixel tint);
 		void DrawPolygonDecal(olc::Decal* decal, const std::vector<olc::vf2d>& pos, const std::vector<float>& depth, const std::vector<olc::vf2d>& uv, const std::vector<olc::Pixel>& colours, const olc::Pixel tint);
+		// As above, but takes pointers to arrays of "elements" vertices. colours and depth may be nullptr
+		void DrawPolygonDecal(olc::Decal* decal, const olc::vf2d* pos, const olc::vf2d* uv, const olc::Pixel* colours, uint32_t elements, const olc::Pixel tint = olc::WHITE);
+		void DrawPolygonDecal(olc::Decal* decal, const olc::vf2d* pos, const float* depth, const olc::vf2d* uv, const olc::Pixel* colours, uint32_t elements, const olc::Pixel tint = olc::WHITE);
 
 		// Draws a line in Decal Space
 		void DrawLineDecal(const olc::vf2d& pos1, const olc::vf2d& pos2, Pixel p = olc::WHITE);
 		void DrawRotatedStringDecal(const olc::vf2d& pos, const std::string& sText, const float fAngle, const olc::vf2d& center = { 0.0f, 0.0f }, const olc::Pixel col = olc::WHITE, const olc::vf2d& scale = { 1.0f, 1.0f });
 		void DrawRotatedStringPropDecal(const olc::vf2d& pos, const std::string& sText, const float fAngle, const olc::vf2d& center = { 0.0f, 0.0f }, const olc::Pixel col = olc::WHITE, const olc::vf2d& scale = { 1.0f, 1.0f });
-		// Clears entire draw target to Pixel
+		// Clears entire draw target to Pixel (overwrites, regardless of pixel mode)
 		void Clear(Pixel p);
 		// Clears the rendering back buffer
 		void ClearBuffer(Pixel p, bool bDepth = true);
@@ -1554,6 +2126,7 @@ namespace olc
 		olc::Sprite* pDrawTarget = nullptr;
 		Pixel::Mode	nPixelMode = Pixel::NORMAL;
 		float		fBlendFactor = 1.0f;
+		uint8_t		nBlendFactor = 255;
 		olc::vi2d	vScreenSize = { 256, 240 };
 		olc::vf2d	vInvScreenSize = { 1.0f / 256.0f, 1.0f / 240.0f };
 		olc::vi2d	vPixelSize = { 4, 4 };
@@ -1591,8 +2164,26 @@ namespace olc
 		bool		bHW3DDepthTest = true;
 		
 		std::function<olc::Pixel(const int x, const int y, const olc::Pixel&, const olc::Pixel&)> funcPixelMode;
-		std::chrono::time_point<std::chrono::system_clock> m_tp1, m_tp2;
+		std::chrono::time_point<std::chrono::steady_clock> m_tp1, m_tp2;
+		// Frame pacing, m_durSleepSlack is how late sleeps have been waking up
+		std::chrono::steady_clock::duration m_durFramePeriod{ 0 };
+		std::chrono::steady_clock::duration m_durSleepSlack = std::chrono::milliseconds(1);
+		std::chrono::time_point<std::chrono::steady_clock> m_tpNextFrame;
+		bool		bPipelinedFrames = false;
+		bool		bFramePending = false;
+#if defined(OLC_PLATFORM_EMSCRIPTEN)
+		// The period the browser's main loop was last asked to run at
+		std::chrono::steady_clock::duration m_durLoopPeriod{ 0 };
+#endif
+		olc::Profiler profiler;
+		// Fixed step simulation
+		float		fFixedStep = 0.0f;
+		float		fFixedAccumulator = 0.0f;
+		float		fFixedAlpha = 0.0f;
+		uint32_t	nFixedMaxSteps = 8;
 		std::vector<olc::vi2d> vFontSpacing;
+		// Each glyph row as 1 bit per pixel, bit 0 is the leftmost column
+		std::array<uint8_t, 96 * 8> vFontMask{};
 		
 		std::vector<std::string> vDroppedFiles;
 		std::vector<std::string> vDroppedFilesCache;
@@ -1636,6 +2227,39 @@ namespace olc
 		// The main engine thread
 		void		EngineThread();
 
+		// Writes a clipped horizontal run of pixels [x1, x2] on row y, straight
+		// into the draw target, honouring the current pixel mode
+		void		SpanFill(int32_t x1, int32_t x2, int32_t y, Pixel p);
+		// As above, but copies nLen pixels from pSrc starting at x
+		void		SpanCopy(int32_t x, int32_t y, const Pixel* pSrc, int32_t nLen);
+		std::vector<Pixel> vSpanScratch;
+
+		// Appends an instance with nPoints vertices to the target layer. Its vertex
+		// pointers are only valid until the next instance is added to that layer
+		olc::DecalInstance& NewDecalInstance(olc::Decal* decal, uint32_t nPoints);
+		// Hands a layer's decals to the renderer, then empties it for the next frame
+		void		SubmitLayerDecals(olc::LayerDesc& layer);
+		// Writes the corners of an axis aligned rectangle in decal vertex order
+		static void	DecalQuadCorners(olc::vf2d* p, const olc::vf2d& tl, const olc::vf2d& br);
+
+		// Walks a triangle in 8x8 blocks with fixed point edge functions and a top-left
+		// fill rule, calling emit(y, x1, x2) with the covered span of each row
+		template<typename F>
+		void		RasterTriangle(const olc::vf2d& p0, const olc::vf2d& p1, const olc::vf2d& p2, F&& emit);
+
+		// Bresenham line walker behind DrawLine() and DrawLines(). Rotates pattern
+		// per pixel, and can leave out the pixel at (x1,y1) when joining lines
+		void		LineWalk(int32_t x1, int32_t y1, int32_t x2, int32_t y2, Pixel p, uint32_t& pattern, bool bSkipFirst);
+
+		// Blits nCols columns of a glyph, starting at column nFirstCol, as
+		// spans built from the font mask, clipped to the draw target
+		void		DrawGlyph(int32_t x, int32_t y, int32_t nGlyph, int32_t nFirstCol, int32_t nCols, Pixel col, uint32_t scale);
+
+		// Walks one quadrant of an ellipse, calling emit(dy, inner, outer) where
+		// outer is the half width of row dy and inner that of the row beyond it
+		template<typename F>
+		void		RasterEllipse(int32_t rx, int32_t ry, F&& emit);
+
 
 		// If anything sets this flag to false, the engine
 		// "should" shut down gracefully
@@ -1650,6 +2274,8 @@ namespace olc
 		void olc_UpdateViewport();
 		void olc_ConstructFontSheet();
 		void olc_CoreUpdate();
+		void olc_PaceFrame();
+		void olc_PresentPendingFrame();
 		void olc_PrepareEngine();
 		void olc_UpdateMouseState(int32_t button, bool state);
 		void olc_UpdateKeyState(int32_t keycode, bool state);
@@ -1692,6 +2318,8 @@ namespace olc
 		virtual void OnAfterUserCreate();
 		virtual bool OnBeforeUserUpdate(float& fElapsedTime);
 		virtual void OnAfterUserUpdate(float fElapsedTime);
+		virtual bool OnBeforeFixedUpdate(float& fFixedTime);
+		virtual void OnAfterFixedUpdate(float fFixedTime);
 
 	protected:
 		static PixelGameEngine* pge;
@@ -1739,12 +2367,18 @@ namespace X11 {
 #include <emscripten/emscripten.h>
 #define CALLSTYLE
 #define GL_CLAMP GL_CLAMP_TO_EDGE
+// WebGL2 has it, but the GLES2 headers dont define it
+#if !defined(GL_UNPACK_ROW_LENGTH)
+#define GL_UNPACK_ROW_LENGTH 0x0CF2
+#endif
 #endif
 
 namespace olc
 {
 	typedef char GLchar;
 	typedef ptrdiff_t GLsizeiptr;
+	typedef ptrdiff_t GLintptr;
+	typedef struct locSync* GLsync;
 
 	typedef GLuint CALLSTYLE locCreateShader_t(GLenum type);
 	typedef GLuint CALLSTYLE locCreateProgram_t(void);
@@ -1755,6 +2389,7 @@ namespace olc
 	typedef void CALLSTYLE locAttachShader_t(GLuint program, GLuint shader);
 	typedef void CALLSTYLE locBindBuffer_t(GLenum target, GLuint buffer);
 	typedef void CALLSTYLE locBufferData_t(GLenum target, GLsizeiptr size, const void* data, GLenum usage);
+	typedef void CALLSTYLE locBufferSubData_t(GLenum target, GLintptr offset, GLsizeiptr size, const void* data);
 	typedef void CALLSTYLE locGenBuffers_t(GLsizei n, GLuint* buffers);
 	typedef void CALLSTYLE locVertexAttribPointer_t(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void* pointer);
 	typedef void CALLSTYLE locEnableVertexAttribArray_t(GLuint index);
@@ -1776,6 +2411,13 @@ namespace olc
 	typedef void CALLSTYLE locFrameBufferTexture2D_t(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level);
 	typedef void CALLSTYLE locDrawBuffers_t(GLsizei n, const GLenum* bufs);
 	typedef void CALLSTYLE locBlendFuncSeparate_t(GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha);
+	typedef void CALLSTYLE locVertexAttribDivisor_t(GLuint index, GLuint divisor);
+	typedef void CALLSTYLE locDrawArraysInstanced_t(GLenum mode, GLint first, GLsizei count, GLsizei instancecount);
+	typedef void* CALLSTYLE locMapBufferRange_t(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access);
+	typedef GLboolean CALLSTYLE locUnmapBuffer_t(GLenum target);
+	typedef GLsync CALLSTYLE locFenceSync_t(GLenum condition, GLbitfield flags);
+	typedef GLenum CALLSTYLE locClientWaitSync_t(GLsync sync, GLbitfield flags, uint64_t timeout);
+	typedef void CALLSTYLE locDeleteSync_t(GLsync sync);
 
 #if defined(OLC_PLATFORM_WINAPI)
 	typedef void __stdcall locSwapInterval_t(GLsizei n);
@@ -1806,6 +2448,20 @@ namespace olc
 #ifdef OLC_PGE_APPLICATION
 #undef OLC_PGE_APPLICATION
 
+// Resource packs are memory mapped
+#if defined(_WIN32)
+#if !defined(NOMINMAX)
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif (defined(__unix__) || defined(__APPLE__)) && !defined(__EMSCRIPTEN__)
+#define OLC_RESOURCEPACK_MMAP
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 // O------------------------------------------------------------------------------O
 // | olcPixelGameEngine INTERFACE IMPLEMENTATION (CORE)                           |
 // | Note: The core implementation is platform independent                        |
@@ -1942,6 +2598,203 @@ namespace olc
 		return (p2 * t) + p1 * (1.0f - t);
 	}
 #endif
+
+	// O------------------------------------------------------------------------------O
+	// | olc::PixelBlend IMPLEMENTATION                                               |
+	// O------------------------------------------------------------------------------O
+	// Every path evaluates round((s * a + d * (255 - a)) / 255) per channel, using
+	// the (t + (t >> 8)) >> 8 division trick, so all fit in 16 bits and the SIMD
+	// kernels produce exactly the same result as the scalar one
+	static inline uint32_t PixelBlendDiv255(uint32_t t)
+	{
+		t += 128; return (t + (t >> 8)) >> 8;
+	}
+
+	Pixel PixelBlend(const olc::Pixel& dst, const olc::Pixel& src, const uint8_t nBlend)
+	{
+		uint32_t a = nBlend == 255 ? src.a : PixelBlendDiv255(src.a * nBlend);
+		uint32_t c = 255 - a;
+		return Pixel(
+			uint8_t(PixelBlendDiv255(src.r * a + dst.r * c)),
+			uint8_t(PixelBlendDiv255(src.g * a + dst.g * c)),
+			uint8_t(PixelBlendDiv255(src.b * a + dst.b * c)));
+	}
+
+#if defined(OLC_SIMD_SSE2)
+	// 4 pixels at a time, channels widened to 16-bit lanes
+	static inline __m128i PixelBlendSSE2(const __m128i d, const __m128i s, const __m128i blend, const bool bScale)
+	{
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i c255 = _mm_set1_epi16(255);
+		auto div255 = [](__m128i t)
+		{
+			t = _mm_add_epi16(t, _mm_set1_epi16(128));
+			return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+		};
+		auto half = [&](const __m128i s16, const __m128i d16)
+		{
+			__m128i a = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s16, 0xFF), 0xFF);
+			if (bScale) a = div255(_mm_mullo_epi16(a, blend));
+			const __m128i c = _mm_sub_epi16(c255, a);
+			return div255(_mm_add_epi16(_mm_mullo_epi16(s16, a), _mm_mullo_epi16(d16, c)));
+		};
+		const __m128i lo = half(_mm_unpacklo_epi8(s, zero), _mm_unpacklo_epi8(d, zero));
+		const __m128i hi = half(_mm_unpackhi_epi8(s, zero), _mm_unpackhi_epi8(d, zero));
+		return _mm_or_si128(_mm_packus_epi16(lo, hi), _mm_set1_epi32(int32_t(0xFF000000)));
+	}
+#endif
+
+#if defined(OLC_SIMD_AVX2)
+	// 8 pixels at a time, unpack/pack work per 128-bit lane so order is preserved
+	static inline __m256i PixelBlendAVX2(const __m256i d, const __m256i s, const __m256i blend, const bool bScale)
+	{
+		const __m256i zero = _mm256_setzero_si256();
+		const __m256i c255 = _mm256_set1_epi16(255);
+		auto div255 = [](__m256i t)
+		{
+			t = _mm256_add_epi16(t, _mm256_set1_epi16(128));
+			return _mm256_srli_epi16(_mm256_add_epi16(t, _mm256_srli_epi16(t, 8)), 8);
+		};
+		auto half = [&](const __m256i s16, const __m256i d16)
+		{
+			__m256i a = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(s16, 0xFF), 0xFF);
+			if (bScale) a = div255(_mm256_mullo_epi16(a, blend));
+			const __m256i c = _mm256_sub_epi16(c255, a);
+			return div255(_mm256_add_epi16(_mm256_mullo_epi16(s16, a), _mm256_mullo_epi16(d16, c)));
+		};
+		const __m256i lo = half(_mm256_unpacklo_epi8(s, zero), _mm256_unpacklo_epi8(d, zero));
+		const __m256i hi = half(_mm256_unpackhi_epi8(s, zero), _mm256_unpackhi_epi8(d, zero));
+		return _mm256_or_si256(_mm256_packus_epi16(lo, hi), _mm256_set1_epi32(int32_t(0xFF000000)));
+	}
+#endif
+
+#if defined(OLC_SIMD_NEON)
+	// 8 pixels at a time, de-interleaved into planar channels
+	static inline uint8x8_t PixelBlendDiv255NEON(uint16x8_t t)
+	{
+		t = vaddq_u16(t, vdupq_n_u16(128));
+		return vshrn_n_u16(vsraq_n_u16(t, t, 8), 8);
+	}
+
+	static inline void PixelBlendNEON(uint8x8x4_t& d, const uint8x8x4_t& s, const uint8_t nBlend)
+	{
+		uint8x8_t a = s.val[3];
+		if (nBlend != 255) a = PixelBlendDiv255NEON(vmull_u8(a, vdup_n_u8(nBlend)));
+		const uint8x8_t c = vsub_u8(vdup_n_u8(255), a);
+		for (int k = 0; k < 3; k++)
+			d.val[k] = PixelBlendDiv255NEON(vmlal_u8(vmull_u8(s.val[k], a), d.val[k], c));
+		d.val[3] = vdup_n_u8(255);
+	}
+#endif
+
+	// bSolid selects a single source colour for the whole run
+	template<bool bSolid>
+	static void PixelBlendRun(olc::Pixel* pDst, const olc::Pixel* pSrc, const size_t nCount, const uint8_t nBlend)
+	{
+		size_t i = 0;
+		const bool bScale = nBlend != 255;
+		UNUSED(bScale);
+#if defined(OLC_SIMD_AVX2)
+		{
+			const __m256i blend = _mm256_set1_epi16(nBlend);
+			const __m256i solid = _mm256_set1_epi32(int32_t(pSrc->n));
+			for (; i + 8 <= nCount; i += 8)
+			{
+				__m256i* p = reinterpret_cast<__m256i*>(pDst + i);
+				const __m256i s = bSolid ? solid : _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pSrc + i));
+				_mm256_storeu_si256(p, PixelBlendAVX2(_mm256_loadu_si256(p), s, blend, bScale));
+			}
+		}
+#endif
+#if defined(OLC_SIMD_SSE2)
+		{
+			const __m128i blend = _mm_set1_epi16(nBlend);
+			const __m128i solid = _mm_set1_epi32(int32_t(pSrc->n));
+			for (; i + 4 <= nCount; i += 4)
+			{
+				__m128i* p = reinterpret_cast<__m128i*>(pDst + i);
+				const __m128i s = bSolid ? solid : _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + i));
+				_mm_storeu_si128(p, PixelBlendSSE2(_mm_loadu_si128(p), s, blend, bScale));
+			}
+		}
+#elif defined(OLC_SIMD_NEON)
+		{
+			uint8x8x4_t solid;
+			for (int k = 0; k < 4; k++) solid.val[k] = vdup_n_u8(reinterpret_cast<const uint8_t*>(pSrc)[k]);
+			for (; i + 8 <= nCount; i += 8)
+			{
+				uint8_t* p = reinterpret_cast<uint8_t*>(pDst + i);
+				uint8x8x4_t d = vld4_u8(p);
+				PixelBlendNEON(d, bSolid ? solid : vld4_u8(reinterpret_cast<const uint8_t*>(pSrc + i)), nBlend);
+				vst4_u8(p, d);
+			}
+		}
+#endif
+		for (; i < nCount; i++)
+			pDst[i] = PixelBlend(pDst[i], bSolid ? *pSrc : pSrc[i], nBlend);
+	}
+
+	void PixelBlendSpan(olc::Pixel* pDst, const olc::Pixel* pSrc, const size_t nCount, const uint8_t nBlend)
+	{
+		PixelBlendRun<false>(pDst, pSrc, nCount, nBlend);
+	}
+
+	void PixelBlendSpan(olc::Pixel* pDst, const olc::Pixel& src, const size_t nCount, const uint8_t nBlend)
+	{
+		// Fully opaque colour is just a fill
+		if (src.a == 255 && nBlend == 255)
+			std::fill(pDst, pDst + nCount, src);
+		else
+			PixelBlendRun<true>(pDst, &src, nCount, nBlend);
+	}
+
+	// Pixel::MASK for runs - copies only the fully opaque source pixels
+	static void PixelMaskSpan(olc::Pixel* pDst, const olc::Pixel* pSrc, const size_t nCount)
+	{
+		size_t i = 0;
+#if defined(OLC_SIMD_SSE2)
+		const __m128i opaque = _mm_set1_epi32(int32_t(0xFF000000));
+		for (; i + 4 <= nCount; i += 4)
+		{
+			__m128i* p = reinterpret_cast<__m128i*>(pDst + i);
+			const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + i));
+			const __m128i m = _mm_cmpeq_epi32(_mm_and_si128(s, opaque), opaque);
+			_mm_storeu_si128(p, _mm_or_si128(_mm_and_si128(m, s), _mm_andnot_si128(m, _mm_loadu_si128(p))));
+		}
+#elif defined(OLC_SIMD_NEON)
+		const uint32x4_t opaque = vdupq_n_u32(0xFF000000);
+		for (; i + 4 <= nCount; i += 4)
+		{
+			uint32_t* p = reinterpret_cast<uint32_t*>(pDst + i);
+			const uint32x4_t s = vld1q_u32(reinterpret_cast<const uint32_t*>(pSrc + i));
+			const uint32x4_t m = vceqq_u32(vandq_u32(s, opaque), opaque);
+			vst1q_u32(p, vbslq_u32(m, s, vld1q_u32(p)));
+		}
+#endif
+		for (; i < nCount; i++)
+			if (pSrc[i].a == 255) pDst[i] = pSrc[i];
+	}
+
+	// Writes a run of pixels in a fixed pixel mode, copying from pSrc, or filling
+	// with p if pSrc is nullptr
+	static void SpanWrite(olc::Pixel* pDst, const olc::Pixel* pSrc, const olc::Pixel& p, const size_t nCount, const olc::Pixel::Mode nMode, const uint8_t nBlend)
+	{
+		switch (nMode)
+		{
+		case olc::Pixel::NORMAL:
+			if (pSrc) std::copy(pSrc, pSrc + nCount, pDst); else std::fill(pDst, pDst + nCount, p);
+			return;
+		case olc::Pixel::MASK:
+			if (pSrc) PixelMaskSpan(pDst, pSrc, nCount); else if (p.a == 255) std::fill(pDst, pDst + nCount, p);
+			return;
+		case olc::Pixel::ALPHA:
+			if (pSrc) PixelBlendSpan(pDst, pSrc, nCount, nBlend); else PixelBlendSpan(pDst, p, nCount, nBlend);
+			return;
+		default:
+			return;
+		}
+	}
+
 	// O------------------------------------------------------------------------------O
 	// | olc::Sprite IMPLEMENTATION                                                   |
 	// O------------------------------------------------------------------------------O
@@ -1964,6 +2817,39 @@ namespace olc
 	{
 		width = w;		height = h;
 		pColData.resize(width * height, nDefaultPixel);
+		MarkDirty();
+	}
+
+	void Sprite::MarkDirty()
+	{
+		vDirtyMin = { 0, 0 };
+		vDirtyMax = { width - 1, height - 1 };
+	}
+
+	void Sprite::MarkDirty(int32_t x1, int32_t y1, int32_t x2, int32_t y2)
+	{
+		// Only written when it grows, which is rare once a frame gets going
+		if (x1 < vDirtyMin.x) vDirtyMin.x = x1;
+		if (y1 < vDirtyMin.y) vDirtyMin.y = y1;
+		if (x2 > vDirtyMax.x) vDirtyMax.x = x2;
+		if (y2 > vDirtyMax.y) vDirtyMax.y = y2;
+	}
+
+	bool Sprite::GetDirtyRect(olc::vi2d& vPos, olc::vi2d& vSize) const
+	{
+		const olc::vi2d vMin = { std::max(vDirtyMin.x, 0), std::max(vDirtyMin.y, 0) };
+		const olc::vi2d vMax = { std::min(vDirtyMax.x, width - 1), std::min(vDirtyMax.y, height - 1) };
+		if (vMin.x > vMax.x || vMin.y > vMax.y) return false;
+		vPos = vMin;
+		vSize = vMax - vMin + olc::vi2d(1, 1);
+		return true;
+	}
+
+	void Sprite::ClearDirty()
+	{
+		vDirtyMin = { INT32_MAX, INT32_MAX };
+		vDirtyMax = { INT32_MIN, INT32_MIN };
+		nDirtyEpoch++;
 	}
 
 	Sprite::~Sprite()
@@ -2009,6 +2895,7 @@ namespace olc
 		if (x >= 0 && x < width && y >= 0 && y < height)
 		{
 			pColData[y * width + x] = p;
+			MarkDirty(x, y, x, y);
 			return true;
 		}
 		else
@@ -2056,20 +2943,40 @@ namespace olc
 
 	Pixel* Sprite::GetData()
 	{
+		MarkDirty();
 		return pColData.data();
 	}
 
 
 	olc::rcode Sprite::LoadFromFile(const std::string& sImageFile, olc::ResourcePack* pack)
 	{
-		UNUSED(pack);
-		return loader->LoadImageResource(this, sImageFile, pack);
+		olc::rcode result = olc::rcode::FAIL;
+		if (olc::ImageLoader::IsNativeImage(sImageFile, pack))
+			result = olc::ImageLoader::LoadNativeImage(this, sImageFile, pack);
+		else if (loader != nullptr)
+			result = loader->LoadImageResource(this, sImageFile, pack);
+		else if (pack == nullptr && !_gfs::exists(sImageFile))
+			result = olc::rcode::NO_FILE;
+		MarkDirty();
+		return result;
+	}
+
+	olc::rcode Sprite::SaveToFile(const std::string& sImageFile)
+	{
+		std::string sExt = _gfs::path(sImageFile).extension().string();
+		std::transform(sExt.begin(), sExt.end(), sExt.begin(), [](char c) { return char(std::tolower(c)); });
+		if (sExt == ".olcspr")
+			return olc::ImageLoader::SaveNativeImage(this, sImageFile);
+		if (sExt == ".png" || sExt == ".qoi" || sExt == ".bmp")
+			return olc::ImageLoader::SaveEncodedImage(this, sImageFile);
+		if (loader == nullptr) return olc::rcode::FAIL;
+		return loader->SaveImageResource(this, sImageFile);
 	}
 
 	olc::Sprite* Sprite::Duplicate()
 	{
 		olc::Sprite* spr = new olc::Sprite(width, height);
-		std::memcpy(spr->GetData(), GetData(), width * height * sizeof(olc::Pixel));
+		std::memcpy(spr->GetData(), pColData.data(), width * height * sizeof(olc::Pixel));
 		spr->modeSample = modeSample;
 		return spr;
 	}
@@ -2108,22 +3015,103 @@ namespace olc
 
 	void Decal::Update()
 	{
-		if (sprite == nullptr) return;
+		// Shared textures are owned by whoever shares them
+		if (sprite == nullptr || bShared) return;
 		vUVScale = { 1.0f / float(sprite->width), 1.0f / float(sprite->height) };
 		renderer->ApplyTexture(id);
 		renderer->UpdateTexture(id, sprite);
+		vTextureSize = sprite->Size();
+		nDirtyEpoch = sprite->nDirtyEpoch;
+	}
+
+	void Decal::UpdateDirty()
+	{
+		if (sprite == nullptr || bShared) return;
+
+		// Something else took the dirty rectangle, so this texture may have
+		// missed changes. Leave the rectangle to whoever is tracking it
+		if (nDirtyEpoch != sprite->nDirtyEpoch)
+		{
+			Update();
+			return;
+		}
+
+		// A resized sprite needs the texture reallocating, otherwise only
+		// what has been drawn to since the last upload is sent
+		olc::vi2d vPos, vSize;
+		if (vTextureSize != sprite->Size())
+			Update();
+		else if (sprite->GetDirtyRect(vPos, vSize))
+		{
+			renderer->ApplyTexture(id);
+			renderer->UpdateTextureRegion(id, sprite, vPos, vSize);
+		}
+		else
+			return;
+
+		sprite->ClearDirty();
+		nDirtyEpoch = sprite->nDirtyEpoch;
 	}
 
 	void Decal::UpdateSprite()
 	{
-		if (sprite == nullptr) return;
+		if (sprite == nullptr || bShared) return;
 		renderer->ApplyTexture(id);
 		renderer->ReadTexture(id, sprite);
+		sprite->ClearDirty();
+		nDirtyEpoch = sprite->nDirtyEpoch;
+	}
+
+	void Decal::UpdateAsync()
+	{
+		if (sprite == nullptr || bShared) return;
+
+		// Reallocating the texture is left to the normal path
+		if (vTextureSize != sprite->Size())
+		{
+			Update();
+			return;
+		}
+
+		// A read still in flight would overwrite the sprite afterwards
+		if (bTransferRead && nTransfer != 0) renderer->TransferComplete(nTransfer, true);
+		renderer->ApplyTexture(id);
+		nTransfer = renderer->UpdateTextureAsync(id, sprite);
+		bTransferRead = false;
+		nDirtyEpoch = sprite->nDirtyEpoch;
+	}
+
+	void Decal::UpdateSpriteAsync()
+	{
+		if (sprite == nullptr || bShared) return;
+
+		// Only one read per decal is in flight at a time
+		if (bTransferRead && nTransfer != 0) renderer->TransferComplete(nTransfer, true);
+		renderer->ApplyTexture(id);
+		nTransfer = renderer->ReadTextureAsync(id, sprite);
+		bTransferRead = true;
+		if (nTransfer == 0) IsTransferComplete();
+	}
+
+	bool Decal::IsTransferComplete()
+	{
+		if (nTransfer != 0 && !renderer->TransferComplete(nTransfer)) return false;
+		if (bTransferRead && sprite)
+		{
+			sprite->ClearDirty();
+			nDirtyEpoch = sprite->nDirtyEpoch;
+		}
+		nTransfer = 0;
+		bTransferRead = false;
+		return true;
 	}
 
 	Decal::~Decal()
 	{
-		if (id != -1)
+		// Dont leave a read pointing at a sprite that may be about to go
+		if (nTransfer != 0) renderer->TransferComplete(nTransfer, true);
+
+		if (id != -1 && !bShared)
 		{
 			renderer->DeleteTexture(id);
 			id = -1;
@@ -2163,55 +3151,672 @@ namespace olc
 	}
 
 	// O------------------------------------------------------------------------------O
-	// | olc::ResourcePack IMPLEMENTATION                                             |
+	// | olc::DecalAtlas IMPLEMENTATION                                               |
 	// O------------------------------------------------------------------------------O
-
-
-	//=============================================================
-	// Resource Packs - Allows you to store files in one large 
-	// scrambled file - Thanks MaGetzUb for debugging a null char in std::stringstream bug
-	ResourceBuffer::ResourceBuffer(std::ifstream& ifs, uint32_t offset, uint32_t size)
+	DecalAtlas::DecalAtlas(uint32_t nPageWidth, uint32_t nPageHeight, bool filter)
 	{
-		vMemory.resize(size);
-		ifs.seekg(offset); ifs.read(vMemory.data(), vMemory.size());
-		setg(vMemory.data(), vMemory.data(), vMemory.data() + size);
+		vPageSize = { int32_t(nPageWidth), int32_t(nPageHeight) };
+		bFilter = filter;
 	}
 
-	ResourcePack::ResourcePack() { }
-	ResourcePack::~ResourcePack() { baseFile.close(); }
-
-	bool ResourcePack::AddFile(const std::string& sFile)
+	olc::Decal* DecalAtlas::Add(olc::Sprite* sprite)
 	{
-		const std::string file = makeposix(sFile);
+		if (sprite == nullptr) return nullptr;
 
-		if (_gfs::exists(file))
+		// Every sprite gets a 1 pixel border of its own edge pixels, so
+		// filtering never pulls in a neighbour
+		const int32_t w = sprite->width + 2;
+		const int32_t h = sprite->height + 2;
+		if (w > vPageSize.x || h > vPageSize.y) return nullptr;
+
+		olc::vi2d vPos;
+		size_t nPage = 0;
+		while (nPage < vPages.size() && !Pack(*vPages[nPage], w, h, vPos))
+			nPage++;
+
+		if (nPage == vPages.size())
 		{
-			sResourceFile e;
-			e.nSize = (uint32_t)_gfs::file_size(file);
-			e.nOffset = 0; // Unknown at this stage			
-			mapFiles[file] = e;
-			return true;
+			auto page = std::make_unique<Page>();
+			page->rPage.Create(vPageSize.x, vPageSize.y, bFilter, true);
+			std::fill_n(page->rPage.Sprite()->GetData(), vPageSize.x * vPageSize.y, olc::BLANK);
+			page->vSkyline.push_back({ 0, 0, vPageSize.x });
+			vPages.push_back(std::move(page));
+			Pack(*vPages.back(), w, h, vPos);
 		}
-		return false;
+
+		olc::Decal* pPageDecal = vPages[nPage]->rPage.Decal();
+		Region region;
+		region.pDecal = std::make_unique<olc::Decal>(uint32_t(pPageDecal->id), sprite);
+		region.pDecal->sprite = sprite;
+		region.pDecal->bShared = true;
+		region.pDecal->vUVScale = pPageDecal->vUVScale;
+		region.pDecal->vUVOffset = olc::vf2d(vPos + olc::vi2d(1, 1)) * pPageDecal->vUVScale;
+		region.pDecal->vUVExtent = olc::vf2d(float(sprite->width), float(sprite->height)) * pPageDecal->vUVScale;
+		region.nPage = nPage;
+		region.vPos = vPos;
+
+		Blit(region);
+		vRegions.push_back(std::move(region));
+		return vRegions.back().pDecal.get();
 	}
 
-	bool ResourcePack::LoadPack(const std::string& sFile, const std::string& sKey)
+	void DecalAtlas::Refresh(olc::Decal* decal)
 	{
-		// Open the resource file
-		baseFile.open(sFile, std::ifstream::binary);
-		if (!baseFile.is_open()) return false;
+		auto it = std::find_if(vRegions.begin(), vRegions.end(), [decal](const Region& r) { return r.pDecal.get() == decal; });
+		if (it != vRegions.end()) Blit(*it);
+	}
 
-		// 1) Read Scrambled index
-		uint32_t nIndexSize = 0;
-		baseFile.read((char*)&nIndexSize, sizeof(uint32_t));
+	void DecalAtlas::Update()
+	{
+		for (auto& page : vPages)
+		{
+			if (page->bDirty)
+			{
+				page->rPage.Decal()->UpdateDirty();
+				page->bDirty = false;
+			}
+		}
+	}
+
+	size_t DecalAtlas::GetPageCount() const
+	{
+		return vPages.size();
+	}
+
+	olc::Decal* DecalAtlas::GetPage(size_t nPage) const
+	{
+		return nPage < vPages.size() ? vPages[nPage]->rPage.Decal() : nullptr;
+	}
+
+	bool DecalAtlas::Pack(Page& page, int32_t w, int32_t h, olc::vi2d& vPos)
+	{
+		auto& sky = page.vSkyline;
+
+		// Find the node where the rectangle would sit lowest, ties go to
+		// whichever wastes the least width
+		size_t nBest = sky.size();
+		int32_t nBestY = INT32_MAX, nBestW = INT32_MAX;
+		for (size_t i = 0; i < sky.size(); i++)
+		{
+			if (sky[i].x + w > vPageSize.x) break;
+
+			// The rectangle rests on the highest node it spans
+			int32_t y = 0, nRemaining = w;
+			for (size_t j = i; nRemaining > 0; j++)
+			{
+				y = std::max(y, sky[j].y);
+				nRemaining -= sky[j].w;
+			}
+
+			if (y + h > vPageSize.y) continue;
+			if (y < nBestY || (y == nBestY && sky[i].w < nBestW))
+			{
+				nBest = i; nBestY = y; nBestW = sky[i].w;
+			}
+		}
+
+		if (nBest == sky.size()) return false;
+
+		vPos = { sky[nBest].x, nBestY };
+		sky.insert(sky.begin() + nBest, { vPos.x, nBestY + h, w });
+
+		// Cut back the nodes now underneath the new one
+		const int32_t nRight = vPos.x + w;
+		size_t i = nBest + 1;
+		while (i < sky.size() && sky[i].x < nRight)
+		{
+			const int32_t nShrink = nRight - sky[i].x;
+			if (nShrink >= sky[i].w)
+				sky.erase(sky.begin() + i);
+			else
+			{
+				sky[i].x += nShrink;
+				sky[i].w -= nShrink;
+				break;
+			}
+		}
+
+		// Merge neighbours at the same height
+		for (i = 0; i + 1 < sky.size();)
+		{
+			if (sky[i].y == sky[i + 1].y)
+			{
+				sky[i].w += sky[i + 1].w;
+				sky.erase(sky.begin() + i + 1);
+			}
+			else
+				i++;
+		}
+
+		return true;
+	}
+
+	void DecalAtlas::Blit(const Region& region)
+	{
+		olc::Sprite* src = region.pDecal->sprite;
+		Page& page = *vPages[region.nPage];
+		olc::Pixel* pDst = page.rPage.Sprite()->pColData.data();
+		const int32_t w = src->width, h = src->height;
+		page.rPage.Sprite()->MarkDirty(region.vPos.x, region.vPos.y, region.vPos.x + w + 1, region.vPos.y + h + 1);
+
+		// Rows -1 and h repeat the first and last rows, and the left and
+		// right columns are repeated the same way
+		for (int32_t y = -1; y <= h; y++)
+		{
+			const olc::Pixel* pSrcRow = src->pColData.data() + std::clamp(y, 0, h - 1) * w;
+			olc::Pixel* pDstRow = pDst + (region.vPos.y + 1 + y) * vPageSize.x + region.vPos.x;
+			pDstRow[0] = pSrcRow[0];
+			std::copy(pSrcRow, pSrcRow + w, pDstRow + 1);
+			pDstRow[w + 1] = pSrcRow[w - 1];
+		}
+
+		page.bDirty = true;
+	}
+
+	// O------------------------------------------------------------------------------O
+	// | olc::Profiler IMPLEMENTATION                                                 |
+	// O------------------------------------------------------------------------------O
+	float Profiler::Frame::Duration() const
+	{
+		return float(nEnd - nStart) * 1e-9f;
+	}
+
+	Profiler::Scope::Scope(olc::Profiler& profiler, const char* sName) : profiler(profiler)
+	{
+		profiler.BeginZone(sName);
+	}
+
+	Profiler::Scope::~Scope()
+	{
+		profiler.EndZone();
+	}
+
+	Profiler::Profiler(size_t nHistory)
+	{
+		// One extra for the frame being recorded
+		vFrames.resize(std::max(nHistory, size_t(1)) + 1);
+		tpEpoch = std::chrono::steady_clock::now();
+	}
+
+	void Profiler::Enable(const bool bEnable)
+	{
+		bEnabled = bEnable;
+	}
+
+	bool Profiler::IsEnabled() const
+	{
+		return bEnabled;
+	}
+
+	int64_t Profiler::Now() const
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - tpEpoch).count();
+	}
+
+	void Profiler::BeginFrame()
+	{
+		bInFrame = bEnabled;
+		if (!bInFrame) return;
+
+		// Clearing keeps the capacity, so a warmed up profiler doesn't allocate
+		Frame& frame = vFrames[nHead];
+		frame.nFrame = nFrameCount++;
+		frame.vZones.clear();
+		frame.vLayers.clear();
+		vOpenZones.clear();
+		frame.nStart = Now();
+	}
+
+	void Profiler::EndFrame()
+	{
+		if (!bInFrame) return;
+		bInFrame = false;
+
+		Frame& frame = vFrames[nHead];
+		frame.nEnd = Now();
+
+		// Close anything left open
+		for (size_t nZone : vOpenZones) frame.vZones[nZone].nEnd = frame.nEnd;
+		vOpenZones.clear();
+
+		nHead = (nHead + 1) % vFrames.size();
+		nComplete = std::min(nComplete + 1, vFrames.size() - 1);
+	}
+
+	void Profiler::BeginZone(const char* sName)
+	{
+		if (!bInFrame) return;
+		Frame& frame = vFrames[nHead];
+		vOpenZones.push_back(frame.vZones.size());
+		frame.vZones.push_back({ sName, uint32_t(vOpenZones.size() - 1), Now(), 0 });
+	}
+
+	void Profiler::EndZone()
+	{
+		if (!bInFrame || vOpenZones.empty()) return;
+		vFrames[nHead].vZones[vOpenZones.back()].nEnd = Now();
+		vOpenZones.pop_back();
+	}
+
+	void Profiler::CountLayer(size_t nLayer, uint32_t nDecals, uint32_t nGPUTasks)
+	{
+		if (!bInFrame) return;
+		Frame& frame = vFrames[nHead];
+		if (frame.vLayers.size() <= nLayer) frame.vLayers.resize(nLayer + 1);
+		frame.vLayers[nLayer] = { nDecals, nGPUTasks };
+	}
+
+	size_t Profiler::GetFrameCount() const
+	{
+		return nComplete;
+	}
+
+	const Profiler::Frame& Profiler::GetFrame(size_t nAgo) const
+	{
+		nAgo = std::min(nAgo, nComplete > 0 ? nComplete - 1 : 0);
+		return vFrames[(nHead + vFrames.size() - 1 - nAgo) % vFrames.size()];
+	}
+
+	bool Profiler::SaveChromeTrace(const std::string& sFile) const
+	{
+		std::ofstream ofs(sFile);
+		if (!ofs.is_open()) return false;
+
+		// Complete events, timestamps in microseconds. Zone names are written
+		// as they are, bar the characters JSON won't have
+		auto Name = [](const char* s)
+			{
+				std::string sName;
+				for (; s && *s; s++)
+				{
+					if (*s == '"' || *s == '\\') sName += '\\';
+					if (uint8_t(*s) >= 0x20) sName += *s;
+				}
+				return sName;
+			};
+
+		ofs << std::fixed << std::setprecision(3);
+		ofs << "{\"traceEvents\":[\n";
+		bool bFirst = true;
+		for (size_t n = nComplete; n > 0; n--)
+		{
+			const Frame& frame = GetFrame(n - 1);
+			ofs << (bFirst ? "" : ",\n") << "{\"name\":\"Frame\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":" << frame.nStart * 1e-3
+				<< ",\"dur\":" << (frame.nEnd - frame.nStart) * 1e-3 << ",\"args\":{\"frame\":" << frame.nFrame << "}}";
+			bFirst = false;
+
+			for (const auto& zone : frame.vZones)
+				ofs << ",\n{\"name\":\"" << Name(zone.sName) << "\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":" << zone.nStart * 1e-3
+					<< ",\"dur\":" << (zone.nEnd - zone.nStart) * 1e-3 << "}";
+
+			for (size_t i = 0; i < frame.vLayers.size(); i++)
+				ofs << ",\n{\"name\":\"Layer " << i << "\",\"ph\":\"C\",\"pid\":1,\"ts\":" << frame.nStart * 1e-3
+					<< ",\"args\":{\"decals\":" << frame.vLayers[i].nDecals << ",\"gpu_tasks\":" << frame.vLayers[i].nGPUTasks << "}}";
+		}
+		ofs << "\n]}\n";
+		return ofs.good();
+	}
+
+	// O------------------------------------------------------------------------------O
+	// | olc::AssetLoader IMPLEMENTATION                                              |
+	// O------------------------------------------------------------------------------O
+	AssetLoader::State AssetLoader::Asset::GetState() const
+	{
+		return nState;
+	}
+
+	bool AssetLoader::Asset::IsReady() const
+	{
+		return nState == State::READY;
+	}
+
+	bool AssetLoader::Asset::IsFailed() const
+	{
+		return nState == State::FAILED;
+	}
+
+	olc::rcode AssetLoader::Asset::GetResult() const
+	{
+		return nState == State::FAILED ? nResult : olc::rcode::OK;
+	}
+
+	olc::Sprite* AssetLoader::Asset::Sprite() const
+	{
+		return IsReady() ? pSprite.get() : nullptr;
+	}
+
+	olc::Decal* AssetLoader::Asset::Decal() const
+	{
+		return IsReady() ? pDecal.get() : nullptr;
+	}
+
+	AssetLoader::AssetLoader(uint32_t nThreads)
+	{
+		if (nThreads == 0)
+			nThreads = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+		for (uint32_t i = 0; i < nThreads; i++)
+			vWorkers.emplace_back(&AssetLoader::Worker, this);
+	}
+
+	AssetLoader::~AssetLoader()
+	{
+		{
+			std::lock_guard<std::mutex> lock(muxQueue);
+			bQuit = true;
+		}
+		cvDecode.notify_all();
+		for (auto& t : vWorkers) t.join();
+
+		// Whatever never got going fails, so nobody polls it forever
+		for (auto& asset : listDecode) Finish(*asset, State::FAILED);
+		for (auto& asset : vUpload) Finish(*asset, State::FAILED);
+	}
+
+	AssetLoader::Handle AssetLoader::LoadSprite(const std::string& sFile, olc::ResourcePack* pack)
+	{
+		auto asset = std::make_shared<Asset>();
+		asset->sFile = sFile;
+		asset->pack = pack;
+		return Queue(asset);
+	}
+
+	AssetLoader::Handle AssetLoader::LoadRenderable(const std::string& sFile, olc::ResourcePack* pack, bool filter, bool clamp)
+	{
+		auto asset = std::make_shared<Asset>();
+		asset->sFile = sFile;
+		asset->pack = pack;
+		asset->bDecal = true;
+		asset->bFilter = filter;
+		asset->bClamp = clamp;
+		return Queue(asset);
+	}
+
+	AssetLoader::Handle AssetLoader::SaveSprite(const olc::Sprite* spr, const std::string& sFile)
+	{
+		auto asset = std::make_shared<Asset>();
+		asset->sFile = sFile;
+		asset->bSave = true;
+		if (spr != nullptr)
+		{
+			asset->pSprite = std::make_unique<olc::Sprite>();
+			asset->pSprite->width = spr->width;
+			asset->pSprite->height = spr->height;
+			asset->pSprite->pColData = spr->pColData;
+		}
+		return Queue(asset);
+	}
+
+	AssetLoader::Handle AssetLoader::Queue(Handle asset)
+	{
+		nPending++;
+		{
+			std::lock_guard<std::mutex> lock(muxQueue);
+			listDecode.push_back(asset);
+		}
+		cvDecode.notify_one();
+		return asset;
+	}
+
+	void AssetLoader::Finish(Asset& asset, const State nState)
+	{
+		asset.nState = nState;
+		nPending--;
+	}
+
+	void AssetLoader::Worker()
+	{
+		while (true)
+		{
+			Handle asset;
+			{
+				std::unique_lock<std::mutex> lock(muxQueue);
+				cvDecode.wait(lock, [&] { return bQuit || !listDecode.empty(); });
+				if (bQuit) return;
+				asset = listDecode.front();
+				listDecode.pop_front();
+			}
+
+			asset->nState = State::DECODING;
+			if (asset->bSave)
+			{
+				// Saving is encoding rather than decoding, and the copy isn't
+				// needed once it's written
+				asset->nResult = asset->pSprite ? asset->pSprite->SaveToFile(asset->sFile) : olc::rcode::FAIL;
+				asset->pSprite.reset();
+			}
+			else
+			{
+				asset->pSprite = std::make_unique<olc::Sprite>();
+				asset->nResult = asset->pSprite->LoadFromFile(asset->sFile, asset->pack);
+				if (asset->nResult != olc::rcode::OK) asset->pSprite.reset();
+			}
+
+			{
+				// Under the lock, so Wait() can't miss the change
+				std::lock_guard<std::mutex> lock(muxQueue);
+				if (asset->bSave)
+					Finish(*asset, asset->nResult == olc::rcode::OK ? State::READY : State::FAILED);
+				else if (!asset->pSprite)
+					Finish(*asset, State::FAILED);
+				else if (!asset->bDecal)
+					Finish(*asset, State::READY);
+				else
+				{
+					// Textures can only be made, and freed, on the engine thread, so
+					// let go of the asset before it can have a decal
+					asset->nState = State::UPLOADING;
+					vUpload.push_back(std::move(asset));
+				}
+			}
+			cvUpload.notify_all();
+		}
+	}
+
+	bool AssetLoader::UploadNext()
+	{
+		Handle asset;
+		{
+			std::lock_guard<std::mutex> lock(muxQueue);
+			if (vUpload.empty()) return false;
+			asset = vUpload.front();
+			vUpload.erase(vUpload.begin());
+		}
+
+		asset->pDecal = std::make_unique<olc::Decal>(asset->pSprite.get(), asset->bFilter, asset->bClamp);
+		std::lock_guard<std::mutex> lock(muxQueue);
+		Finish(*asset, State::READY);
+		return true;
+	}
+
+	void AssetLoader::Update(const float fBudget)
+	{
+		const auto tpStart = std::chrono::steady_clock::now();
+		while (UploadNext())
+		{
+			if (std::chrono::duration<float>(std::chrono::steady_clock::now() - tpStart).count() >= fBudget)
+				return;
+		}
+	}
+
+	void AssetLoader::Wait()
+	{
+		while (true)
+		{
+			while (UploadNext());
+			std::unique_lock<std::mutex> lock(muxQueue);
+			cvUpload.wait(lock, [&] { return nPending == 0 || !vUpload.empty(); });
+			if (nPending == 0) return;
+		}
+	}
+
+	size_t AssetLoader::GetPending() const
+	{
+		return nPending;
+	}
+
+	// O------------------------------------------------------------------------------O
+	// | olc::ResourcePack IMPLEMENTATION                                             |
+	// O------------------------------------------------------------------------------O
+
+
+	//=============================================================
+	// Resource Packs - Allows you to store files in one large 
+	// scrambled file - Thanks MaGetzUb for debugging a null char in std::stringstream bug
+	ResourceBuffer::ResourceBuffer(std::ifstream& ifs, uint32_t offset, uint32_t size)
+	{
+		vMemory.resize(size);
+		ifs.seekg(offset); ifs.read(vMemory.data(), vMemory.size());
+		setg(vMemory.data(), vMemory.data(), vMemory.data() + size);
+	}
+
+	ResourceBuffer::ResourceBuffer(const ResourceView& view)
+	{
+		vMemory.assign((const char*)view.data(), (const char*)view.data() + view.size());
+		setg(vMemory.data(), vMemory.data(), vMemory.data() + vMemory.size());
+	}
+
+	ResourceViewBuffer::ResourceViewBuffer(const ResourceView& view)
+	{
+		// The get area is only ever read, so the const can go
+		char* p = (char*)view.data();
+		setg(p, p, p + view.size());
+	}
+
+	ResourceViewBuffer::pos_type ResourceViewBuffer::seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which)
+	{
+		if (dir == std::ios_base::cur) off += gptr() - eback();
+		else if (dir == std::ios_base::end) off += egptr() - eback();
+		return seekpos(pos_type(off), which);
+	}
+
+	ResourceViewBuffer::pos_type ResourceViewBuffer::seekpos(pos_type pos, std::ios_base::openmode which)
+	{
+		const off_type off = off_type(pos);
+		if (!(which & std::ios_base::in) || off < 0 || off > egptr() - eback()) return pos_type(off_type(-1));
+		setg(eback(), eback() + off, egptr());
+		return pos;
+	}
+
+	ResourcePack::ResourcePack() { }
+	ResourcePack::~ResourcePack() { UnmapPack(); }
+
+	bool ResourcePack::MapPack(const std::string& sFile)
+	{
+		UnmapPack();
+#if defined(_WIN32)
+		HANDLE hFile = CreateFileA(sFile.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (hFile == INVALID_HANDLE_VALUE) return false;
+		LARGE_INTEGER nSize;
+		GetFileSizeEx(hFile, &nSize);
+		HANDLE hMapping = nSize.QuadPart > 0 ? CreateFileMappingA(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+		const void* pView = hMapping ? MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+		if (!pView)
+		{
+			if (hMapping) CloseHandle(hMapping);
+			CloseHandle(hFile);
+			return false;
+		}
+		hPackFile = hFile;
+		hPackMapping = hMapping;
+		pPackData = (const uint8_t*)pView;
+		nPackSize = size_t(nSize.QuadPart);
+#elif defined(OLC_RESOURCEPACK_MMAP)
+		int fd = open(sFile.c_str(), O_RDONLY);
+		if (fd < 0) return false;
+		struct stat st;
+		void* pView = MAP_FAILED;
+		if (fstat(fd, &st) == 0 && st.st_size > 0)
+			pView = mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+		// The mapping outlives the descriptor
+		close(fd);
+		if (pView == MAP_FAILED) return false;
+		pPackData = (const uint8_t*)pView;
+		nPackSize = size_t(st.st_size);
+#else
+		std::ifstream ifs(sFile, std::ifstream::binary);
+		if (!ifs.is_open()) return false;
+		vPackData.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+		if (vPackData.empty()) return false;
+		pPackData = vPackData.data();
+		nPackSize = vPackData.size();
+#endif
+		return true;
+	}
+
+	void ResourcePack::UnmapPack()
+	{
+		if (pPackData == nullptr) return;
+#if defined(_WIN32)
+		UnmapViewOfFile(pPackData);
+		CloseHandle(HANDLE(hPackMapping));
+		CloseHandle(HANDLE(hPackFile));
+		hPackMapping = nullptr;
+		hPackFile = nullptr;
+#elif defined(OLC_RESOURCEPACK_MMAP)
+		munmap((void*)pPackData, nPackSize);
+#else
+		vPackData.clear();
+		vPackData.shrink_to_fit();
+#endif
+		pPackData = nullptr;
+		nPackSize = 0;
+
+		vIndex.clear();
+		pEntries = nullptr;
+		pSlots = nullptr;
+		pNames = nullptr;
+		nEntries = 0;
+		nSlots = 0;
+		nNamesSize = 0;
+		std::lock_guard<std::mutex> lock(muxUnpacked);
+		mapUnpacked.clear();
+	}
+
+	bool ResourcePack::AddFile(const std::string& sFile, const bool bCompress)
+	{
+		const std::string file = makeposix(sFile);
+
+		if (_gfs::exists(file))
+		{
+			sResourceFile e;
+			e.nSize = uint64_t(_gfs::file_size(file));
+			e.nOffset = 0; // Unknown at this stage
+			e.bCompress = bCompress;
+			mapFiles[file] = e;
+			return true;
+		}
+		return false;
+	}
+
+	bool ResourcePack::LoadPack(const std::string& sFile, const std::string& sKey)
+	{
+		// Map the resource file
+		if (!MapPack(sFile)) return false;
+
+		if (nPackSize >= sizeof(PackHeader) && std::memcmp(pPackData, "olcRPAK2", 8) == 0)
+		{
+			if (LoadPackV2(sKey)) return true;
+			UnmapPack();
+			return false;
+		}
+
+		// 1) Read Scrambled index
+		uint32_t nIndexSize = 0;
+		if (nPackSize >= sizeof(uint32_t)) std::memcpy(&nIndexSize, pPackData, sizeof(uint32_t));
+		if (nPackSize < sizeof(uint32_t) || nIndexSize > nPackSize - sizeof(uint32_t))
+		{
+			UnmapPack();
+			return false;
+		}
 
-		std::vector<char> buffer(nIndexSize);
-		for (uint32_t j = 0; j < nIndexSize; j++)
-			buffer[j] = baseFile.get();
+		std::vector<char> buffer(pPackData + sizeof(uint32_t), pPackData + sizeof(uint32_t) + nIndexSize);
 
 		std::vector<char> decoded = scramble(buffer, sKey);
 		size_t pos = 0;
-		auto read = [&decoded, &pos](char* dst, size_t size) {
+		bool bOverrun = false;
+		auto read = [&decoded, &pos, &bOverrun](char* dst, size_t size) {
+			// A wrong key makes nonsense of the sizes
+			if (size > decoded.size() - std::min(pos, decoded.size())) { bOverrun = true; std::memset(dst, 0, size); return; }
 			memcpy((void*)dst, (const void*)(decoded.data() + pos), size);
 			pos += size;
 			};
@@ -2221,125 +3826,882 @@ namespace olc
 		// 2) Read Map
 		uint32_t nMapEntries = 0;
 		read((char*)&nMapEntries, sizeof(uint32_t));
-		for (uint32_t i = 0; i < nMapEntries; i++)
+		for (uint32_t i = 0; i < nMapEntries && !bOverrun; i++)
 		{
 			uint32_t nFilePathSize = 0;
 			read((char*)&nFilePathSize, sizeof(uint32_t));
+			if (nFilePathSize > decoded.size()) break;
 
 			std::string sFileName(nFilePathSize, ' ');
 			for (uint32_t j = 0; j < nFilePathSize; j++)
 				sFileName[j] = get();
 
-			sResourceFile e;
-			read((char*)&e.nSize, sizeof(uint32_t));
-			read((char*)&e.nOffset, sizeof(uint32_t));
-			mapFiles[sFileName] = e;
+			uint32_t nSize = 0, nOffset = 0;
+			read((char*)&nSize, sizeof(uint32_t));
+			read((char*)&nOffset, sizeof(uint32_t));
+			mapFiles[sFileName] = { nSize, nOffset };
+		}
+
+		// Don't unmap the file! Views of it are handed
+		// out when files are requested
+		return true;
+	}
+
+	bool ResourcePack::LoadPackV2(const std::string& sKey)
+	{
+		PackHeader header;
+		std::memcpy(&header, pPackData, sizeof(PackHeader));
+		if (header.nVersion != nPackVersion) return false;
+		if (header.nIndexOffset > nPackSize || header.nIndexSize > nPackSize - header.nIndexOffset) return false;
+
+		// The index comes in with one read, and is used as it is from then on
+		std::vector<char> buffer(pPackData + header.nIndexOffset, pPackData + header.nIndexOffset + header.nIndexSize);
+		vIndex = (header.nFlags & nPackFlagScrambled) ? scramble(buffer, sKey) : std::move(buffer);
+		if (Checksum((const uint8_t*)vIndex.data(), vIndex.size()) != header.nIndexChecksum) return false;
+
+		// Slots are a power of 2, with at least one always empty
+		if (header.nSlots == 0 || (header.nSlots & (header.nSlots - 1)) != 0 || header.nEntries >= header.nSlots) return false;
+		const uint64_t nTables = header.nEntries * sizeof(PackEntry) + header.nSlots * sizeof(uint32_t);
+		if (header.nSlots > vIndex.size() || nTables > vIndex.size()) return false;
+
+		nEntries = header.nEntries;
+		nSlots = header.nSlots;
+		pEntries = (const PackEntry*)vIndex.data();
+		pSlots = (const uint32_t*)(vIndex.data() + nEntries * sizeof(PackEntry));
+		pNames = vIndex.data() + nTables;
+		nNamesSize = size_t(vIndex.size() - nTables);
+		return true;
+	}
+
+	bool ResourcePack::SavePack(const std::string& sFile, const std::string& sKey)
+	{
+		// Create/Overwrite the resource file
+		std::ofstream ofs(sFile, std::ofstream::binary);
+		if (!ofs.is_open()) return false;
+
+		// 1) Write each file on a fresh page, after a page for the header
+		const std::vector<char> vPadding(nPackAlignment, 0);
+		auto Align = [&](uint64_t nOffset)
+			{
+				const uint64_t nPad = (nPackAlignment - nOffset % nPackAlignment) % nPackAlignment;
+				ofs.write(vPadding.data(), std::streamsize(nPad));
+				return nOffset + nPad;
+			};
+
+		ofs.write(vPadding.data(), nPackAlignment);
+		uint64_t nOffset = nPackAlignment;
+
+		std::vector<PackEntry> vEntries;
+		std::string sNames;
+		for (auto& e : mapFiles)
+		{
+			std::vector<uint8_t> vBuffer(size_t(e.second.nSize));
+			std::ifstream i(e.first, std::ifstream::binary);
+			i.read((char*)vBuffer.data(), std::streamsize(vBuffer.size()));
+			if (!i) return false;
+
+			PackEntry entry = {};
+			entry.nHash = HashName(e.first);
+			entry.nRawSize = vBuffer.size();
+			entry.nChecksum = Checksum(vBuffer.data(), vBuffer.size());
+			entry.nNameOffset = uint32_t(sNames.size());
+			entry.nNameLength = uint32_t(e.first.size());
+			sNames += e.first;
+
+			// Only keep the compressed version if it's worth it
+			if (e.second.bCompress)
+			{
+				std::vector<uint8_t> vPacked = Compress(vBuffer.data(), vBuffer.size());
+				if (vPacked.size() < vBuffer.size())
+				{
+					vBuffer.swap(vPacked);
+					entry.nCodec = CODEC_LZ;
+				}
+			}
+
+			nOffset = Align(nOffset);
+			entry.nOffset = nOffset;
+			entry.nSize = vBuffer.size();
+			ofs.write((const char*)vBuffer.data(), std::streamsize(vBuffer.size()));
+			nOffset += vBuffer.size();
+			vEntries.push_back(entry);
+		}
+
+		// 2) Build the index. Twice as many slots as entries keeps probes short
+		uint64_t nTableSlots = 1;
+		while (nTableSlots < vEntries.size() * 2 + 1) nTableSlots <<= 1;
+		std::vector<uint32_t> vSlots(size_t(nTableSlots), 0);
+		for (size_t i = 0; i < vEntries.size(); i++)
+		{
+			uint64_t nSlot = vEntries[i].nHash & (nTableSlots - 1);
+			while (vSlots[size_t(nSlot)] != 0) nSlot = (nSlot + 1) & (nTableSlots - 1);
+			vSlots[size_t(nSlot)] = uint32_t(i + 1);
+		}
+
+		std::vector<char> vIndexData(vEntries.size() * sizeof(PackEntry) + vSlots.size() * sizeof(uint32_t) + sNames.size());
+		char* p = vIndexData.data();
+		if (!vEntries.empty()) std::memcpy(p, vEntries.data(), vEntries.size() * sizeof(PackEntry));
+		p += vEntries.size() * sizeof(PackEntry);
+		std::memcpy(p, vSlots.data(), vSlots.size() * sizeof(uint32_t));
+		p += vSlots.size() * sizeof(uint32_t);
+		std::memcpy(p, sNames.data(), sNames.size());
+
+		PackHeader header = {};
+		std::memcpy(header.sMagic, "olcRPAK2", 8);
+		header.nVersion = nPackVersion;
+		header.nFlags = sKey.empty() ? 0 : nPackFlagScrambled;
+		header.nEntries = vEntries.size();
+		header.nSlots = nTableSlots;
+		header.nIndexOffset = nOffset;
+		header.nIndexSize = vIndexData.size();
+		header.nIndexChecksum = Checksum((const uint8_t*)vIndexData.data(), vIndexData.size());
+		header.nAlignment = nPackAlignment;
+
+		// 3) Scramble index onto the end, then go back for the header
+		std::vector<char> vScrambled = scramble(vIndexData, sKey);
+		ofs.write(vScrambled.data(), std::streamsize(vScrambled.size()));
+		ofs.seekp(0, std::ios::beg);
+		ofs.write((const char*)&header, sizeof(PackHeader));
+		ofs.close();
+		return !ofs.fail();
+	}
+
+	ResourceBuffer ResourcePack::GetFileBuffer(const std::string& sFile)
+	{
+		return ResourceBuffer(GetFileView(sFile));
+	}
+
+	ResourceView ResourcePack::GetFileView(const std::string& sFile) const
+	{
+		if (pPackData == nullptr) return {};
+
+		if (pEntries == nullptr)
+		{
+			auto it = mapFiles.find(sFile);
+			if (it == mapFiles.end()) return {};
+
+			// Entries running off the end of a damaged pack read as empty
+			const sResourceFile& e = it->second;
+			if (e.nOffset > nPackSize || e.nSize > nPackSize - e.nOffset) return {};
+			return { pPackData + e.nOffset, size_t(e.nSize) };
+		}
+
+		const PackEntry* e = FindEntry(sFile);
+		if (e == nullptr || e->nOffset > nPackSize || e->nSize > nPackSize - e->nOffset) return {};
+		if (e->nCodec == CODEC_NONE) return { pPackData + e->nOffset, size_t(e->nSize) };
+		if (e->nCodec != CODEC_LZ) return {};
+
+		std::lock_guard<std::mutex> lock(muxUnpacked);
+		const uint64_t nEntry = uint64_t(e - pEntries);
+		auto it = mapUnpacked.find(nEntry);
+		if (it == mapUnpacked.end())
+		{
+			std::vector<uint8_t> vData(size_t(e->nRawSize));
+			if (!Decompress(pPackData + e->nOffset, size_t(e->nSize), vData.data(), vData.size())
+				|| Checksum(vData.data(), vData.size()) != e->nChecksum)
+				return {};
+			it = mapUnpacked.emplace(nEntry, std::move(vData)).first;
+		}
+		return { it->second.data(), it->second.size() };
+	}
+
+	std::vector<std::string> ResourcePack::GetFileList() const
+	{
+		std::vector<std::string> vFiles;
+		if (pEntries == nullptr)
+		{
+			for (const auto& e : mapFiles) vFiles.push_back(e.first);
+		}
+		else
+		{
+			for (uint64_t i = 0; i < nEntries; i++) vFiles.push_back(EntryName(pEntries[i]));
+		}
+		return vFiles;
+	}
+
+	bool ResourcePack::VerifyPack() const
+	{
+		if (pPackData == nullptr) return false;
+		for (uint64_t i = 0; i < nEntries; i++)
+		{
+			const PackEntry& e = pEntries[i];
+			ResourceView rv = GetFileView(EntryName(e));
+			if (rv.size() != e.nRawSize || (rv.empty() && e.nRawSize > 0)) return false;
+			if (Checksum(rv.data(), rv.size()) != e.nChecksum) return false;
+		}
+		return true;
+	}
+
+	bool ResourcePack::Loaded()
+	{
+		return pPackData != nullptr;
+	}
+
+	const ResourcePack::PackEntry* ResourcePack::FindEntry(const std::string& sFile) const
+	{
+		const uint64_t nHash = HashName(sFile);
+		for (uint64_t nSlot = nHash & (nSlots - 1); pSlots[nSlot] != 0; nSlot = (nSlot + 1) & (nSlots - 1))
+		{
+			if (pSlots[nSlot] > nEntries) return nullptr;
+			const PackEntry& e = pEntries[pSlots[nSlot] - 1];
+			if (e.nHash == nHash && e.nNameLength == sFile.size() && EntryName(e) == sFile) return &e;
+		}
+		return nullptr;
+	}
+
+	std::string ResourcePack::EntryName(const PackEntry& e) const
+	{
+		if (e.nNameOffset > nNamesSize || e.nNameLength > nNamesSize - e.nNameOffset) return {};
+		return std::string(pNames + e.nNameOffset, e.nNameLength);
+	}
+
+	uint64_t ResourcePack::HashName(const std::string& sName)
+	{
+		// FNV-1a
+		uint64_t h = 0xcbf29ce484222325ULL;
+		for (const char c : sName) h = (h ^ uint8_t(c)) * 0x100000001b3ULL;
+		return h;
+	}
+
+	uint32_t ResourcePack::Checksum(const uint8_t* pData, size_t nSize)
+	{
+		// CRC-32, as used by zip and png
+		static const std::array<uint32_t, 256> crc = []()
+			{
+				std::array<uint32_t, 256> t{};
+				for (uint32_t i = 0; i < 256; i++)
+				{
+					uint32_t c = i;
+					for (int k = 0; k < 8; k++) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+					t[i] = c;
+				}
+				return t;
+			}();
+
+		uint32_t c = 0xFFFFFFFFu;
+		for (size_t i = 0; i < nSize; i++) c = crc[(c ^ pData[i]) & 0xFF] ^ (c >> 8);
+		return c ^ 0xFFFFFFFFu;
+	}
+
+	// Compression is the LZ4 block format. Each sequence is a token, holding the
+	// literal count and match length (-4) as nibbles, then the literals, then a
+	// 16 bit backwards offset to the match. A nibble of 15 continues into extra
+	// bytes, added up until one isn't 255. The last sequence is literals only
+	std::vector<uint8_t> ResourcePack::Compress(const uint8_t* pData, size_t nSize)
+	{
+		std::vector<uint8_t> vOut;
+		vOut.reserve(nSize + nSize / 255 + 16);
+
+		auto Length = [&vOut](size_t nLength)
+			{
+				for (; nLength >= 255; nLength -= 255) vOut.push_back(255);
+				vOut.push_back(uint8_t(nLength));
+			};
+
+		auto Literals = [&](size_t nFrom, size_t nTo, size_t nMatch)
+			{
+				const size_t nLiterals = nTo - nFrom;
+				vOut.push_back(uint8_t((std::min(nLiterals, size_t(15)) << 4) | std::min(nMatch, size_t(15))));
+				if (nLiterals >= 15) Length(nLiterals - 15);
+				vOut.insert(vOut.end(), pData + nFrom, pData + nTo);
+			};
+
+		// Last position seen for each hash of 4 bytes, greedy matching. The format
+		// wants the last 5 bytes as literals, and no match starting in the last 12
+		std::vector<int64_t> vTable(size_t(1) << 14, -1);
+		size_t nAnchor = 0, i = 0;
+		const size_t nMatchLimit = nSize > 12 ? nSize - 12 : 0;
+		while (i < nMatchLimit)
+		{
+			uint32_t nSeq;
+			std::memcpy(&nSeq, pData + i, 4);
+			const size_t nHash = (nSeq * 2654435761u) >> 18;
+			const int64_t nCandidate = vTable[nHash];
+			vTable[nHash] = int64_t(i);
+
+			if (nCandidate < 0 || i - size_t(nCandidate) > 65535 || std::memcmp(pData + nCandidate, pData + i, 4) != 0)
+			{
+				i++;
+				continue;
+			}
+
+			size_t nLength = 4;
+			while (i + nLength < nSize - 5 && pData[nCandidate + nLength] == pData[i + nLength]) nLength++;
+
+			Literals(nAnchor, i, nLength - 4);
+			const size_t nDistance = i - size_t(nCandidate);
+			vOut.push_back(uint8_t(nDistance & 0xFF));
+			vOut.push_back(uint8_t(nDistance >> 8));
+			if (nLength - 4 >= 15) Length(nLength - 4 - 15);
+
+			i += nLength;
+			nAnchor = i;
+		}
+
+		Literals(nAnchor, nSize, 0);
+		return vOut;
+	}
+
+	bool ResourcePack::Decompress(const uint8_t* pSrc, size_t nSrcSize, uint8_t* pDst, size_t nDstSize)
+	{
+		size_t s = 0, d = 0;
+		auto Length = [&](size_t& nLength)
+			{
+				uint8_t b;
+				do
+				{
+					if (s >= nSrcSize) return false;
+					b = pSrc[s++];
+					nLength += b;
+				} while (b == 255);
+				return true;
+			};
+
+		while (s < nSrcSize)
+		{
+			const uint8_t nToken = pSrc[s++];
+
+			size_t nLiterals = nToken >> 4;
+			if (nLiterals == 15 && !Length(nLiterals)) return false;
+			if (nLiterals > nSrcSize - s || nLiterals > nDstSize - d) return false;
+			if (nLiterals > 0) std::memcpy(pDst + d, pSrc + s, nLiterals);
+			s += nLiterals; d += nLiterals;
+
+			// The last sequence has no match
+			if (s == nSrcSize) break;
+
+			if (nSrcSize - s < 2) return false;
+			const size_t nDistance = size_t(pSrc[s]) | (size_t(pSrc[s + 1]) << 8);
+			s += 2;
+			if (nDistance == 0 || nDistance > d) return false;
+
+			size_t nLength = nToken & 0x0F;
+			if (nLength == 15 && !Length(nLength)) return false;
+			nLength += 4;
+			if (nLength > nDstSize - d) return false;
+
+			// Matches may overlap themselves, which repeats the pattern
+			if (nDistance >= nLength)
+				std::memcpy(pDst + d, pDst + d - nDistance, nLength);
+			else
+				for (size_t k = 0; k < nLength; k++) pDst[d + k] = pDst[d + k - nDistance];
+			d += nLength;
+		}
+
+		return d == nDstSize;
+	}
+
+	std::vector<char> ResourcePack::scramble(const std::vector<char>& data, const std::string& key)
+	{
+		if (key.empty()) return data;
+		std::vector<char> o;
+		size_t c = 0;
+		for (auto s : data)	o.push_back(s ^ key[(c++) % key.size()]);
+		return o;
+	};
+
+	std::string ResourcePack::makeposix(const std::string& path)
+	{
+		std::string o;
+		for (auto s : path) o += std::string(1, s == '\\' ? '/' : s);
+		return o;
+	};
+
+	// O------------------------------------------------------------------------------O
+	// | olc::ImageLoader IMPLEMENTATION - Native images                              |
+	// O------------------------------------------------------------------------------O
+	// The file is the header, with a fixed table of levels, then each level's
+	// pixels one after the other. Level 0 is the full sized image
+
+	bool ImageLoader::ReadNativeHeader(const std::string& sImageFile, olc::ResourcePack* pack, NativeHeader& header, uint64_t& nFileSize)
+	{
+		if (pack != nullptr)
+		{
+			ResourceView rv = pack->GetFileView(sImageFile);
+			if (rv.size() < sizeof(NativeHeader)) return false;
+			std::memcpy(&header, rv.data(), sizeof(NativeHeader));
+			nFileSize = rv.size();
+		}
+		else
+		{
+			std::ifstream ifs(sImageFile, std::ifstream::binary);
+			if (!ifs.is_open()) return false;
+			ifs.seekg(0, std::ios::end);
+			nFileSize = uint64_t(ifs.tellg());
+			ifs.seekg(0, std::ios::beg);
+			if (nFileSize < sizeof(NativeHeader)) return false;
+			ifs.read((char*)&header, sizeof(NativeHeader));
+			if (!ifs) return false;
+		}
+
+		if (std::memcmp(header.sMagic, "olcSPRv1", 8) != 0) return false;
+		if (header.nVersion != nNativeVersion || header.nLevels == 0 || header.nLevels > nNativeMaxLevels) return false;
+		if (header.nCodec != 0 && header.nCodec != nNativeCodecLZ) return false;
+
+		// Make sure every level is where it says it is before anything trusts it.
+		// Only compressed levels may be a different size to their pixels
+		for (uint32_t i = 0; i < header.nLevels; i++)
+		{
+			const NativeLevel& l = header.level[i];
+			if (l.nWidth == 0 || l.nHeight == 0 || l.nWidth > 65536 || l.nHeight > 65536) return false;
+			if (l.nOffset > nFileSize || l.nSize > nFileSize - l.nOffset) return false;
+			if (header.nCodec != nNativeCodecLZ && l.nSize != uint64_t(l.nWidth) * l.nHeight * sizeof(olc::Pixel)) return false;
+		}
+		return true;
+	}
+
+	bool ImageLoader::IsNativeImage(const std::string& sImageFile, olc::ResourcePack* pack)
+	{
+		char sMagic[8] = { 0 };
+		if (pack != nullptr)
+		{
+			ResourceView rv = pack->GetFileView(sImageFile);
+			if (rv.size() < 8) return false;
+			std::memcpy(sMagic, rv.data(), 8);
+		}
+		else
+		{
+			std::ifstream ifs(sImageFile, std::ifstream::binary);
+			if (!ifs.read(sMagic, 8)) return false;
+		}
+		return std::memcmp(sMagic, "olcSPRv1", 8) == 0;
+	}
+
+	uint32_t ImageLoader::GetNativeLevels(const std::string& sImageFile, olc::ResourcePack* pack)
+	{
+		NativeHeader header;
+		uint64_t nFileSize = 0;
+		if (!ReadNativeHeader(sImageFile, pack, header, nFileSize)) return 0;
+		return header.nLevels;
+	}
+
+	olc::rcode ImageLoader::LoadNativeImage(olc::Sprite* spr, const std::string& sImageFile, olc::ResourcePack* pack, uint32_t nLevel)
+	{
+		if (pack == nullptr && !_gfs::exists(sImageFile)) return olc::rcode::NO_FILE;
+
+		NativeHeader header;
+		uint64_t nFileSize = 0;
+		if (!ReadNativeHeader(sImageFile, pack, header, nFileSize)) return olc::rcode::FAIL;
+
+		// Asking for a level that isn't there gets the smallest one
+		const NativeLevel& level = header.level[std::min(nLevel, header.nLevels - 1)];
+		spr->width = int32_t(level.nWidth);
+		spr->height = int32_t(level.nHeight);
+		spr->pColData.resize(size_t(spr->width) * size_t(spr->height));
+		uint8_t* pDst = (uint8_t*)spr->pColData.data();
+		const size_t nRawSize = spr->pColData.size() * sizeof(olc::Pixel);
+
+		bool bOK = true;
+		if (pack != nullptr)
+		{
+			const uint8_t* pSrc = pack->GetFileView(sImageFile).data() + level.nOffset;
+			if (header.nCodec == nNativeCodecLZ)
+				bOK = ResourcePack::Decompress(pSrc, size_t(level.nSize), pDst, nRawSize);
+			else
+				std::memcpy(pDst, pSrc, nRawSize);
+		}
+		else
+		{
+			std::ifstream ifs(sImageFile, std::ifstream::binary);
+			ifs.seekg(std::streamoff(level.nOffset));
+			if (header.nCodec == nNativeCodecLZ)
+			{
+				std::vector<uint8_t> vPacked(size_t(level.nSize));
+				bOK = ifs.read((char*)vPacked.data(), std::streamsize(vPacked.size()))
+					&& ResourcePack::Decompress(vPacked.data(), vPacked.size(), pDst, nRawSize);
+			}
+			else
+			{
+				// Uncompressed, so the pixels go straight into the sprite
+				bOK = bool(ifs.read((char*)pDst, std::streamsize(nRawSize)));
+			}
+		}
+
+		if (!bOK)
+		{
+			spr->width = 0;
+			spr->height = 0;
+			spr->pColData.clear();
+			return olc::rcode::FAIL;
+		}
+		return olc::rcode::OK;
+	}
+
+	olc::rcode ImageLoader::SaveNativeImage(const olc::Sprite* spr, const std::string& sImageFile, bool bMipMaps, bool bCompress)
+	{
+		if (spr == nullptr || spr->width <= 0 || spr->height <= 0) return olc::rcode::FAIL;
+
+		NativeHeader header;
+		std::memset(&header, 0, sizeof(NativeHeader));
+		std::memcpy(header.sMagic, "olcSPRv1", 8);
+		header.nVersion = nNativeVersion;
+		header.nCodec = bCompress ? nNativeCodecLZ : 0;
+
+		// Each mip level is a 2x2 box filter of the one above, odd edges
+		// just reuse their last row or column
+		std::vector<std::vector<olc::Pixel>> vLevels;
+		std::vector<olc::vi2d> vSizes;
+		vLevels.push_back(spr->pColData);
+		vSizes.push_back(spr->Size());
+		while (bMipMaps && vLevels.size() < nNativeMaxLevels && (vSizes.back().x > 1 || vSizes.back().y > 1))
+		{
+			const olc::vi2d s = vSizes.back();
+			const olc::vi2d d = { std::max(1, s.x / 2), std::max(1, s.y / 2) };
+			const std::vector<olc::Pixel>& src = vLevels.back();
+			std::vector<olc::Pixel> dst(size_t(d.x) * size_t(d.y));
+			for (int32_t y = 0; y < d.y; y++)
+				for (int32_t x = 0; x < d.x; x++)
+				{
+					const int32_t x0 = std::min(x * 2, s.x - 1), x1 = std::min(x * 2 + 1, s.x - 1);
+					const int32_t y0 = std::min(y * 2, s.y - 1), y1 = std::min(y * 2 + 1, s.y - 1);
+					const olc::Pixel p[4] = { src[y0 * s.x + x0], src[y0 * s.x + x1], src[y1 * s.x + x0], src[y1 * s.x + x1] };
+					dst[y * d.x + x] = olc::Pixel(
+						uint8_t((p[0].r + p[1].r + p[2].r + p[3].r + 2) / 4),
+						uint8_t((p[0].g + p[1].g + p[2].g + p[3].g + 2) / 4),
+						uint8_t((p[0].b + p[1].b + p[2].b + p[3].b + 2) / 4),
+						uint8_t((p[0].a + p[1].a + p[2].a + p[3].a + 2) / 4));
+				}
+			vLevels.push_back(std::move(dst));
+			vSizes.push_back(d);
+		}
+
+		header.nLevels = uint32_t(vLevels.size());
+		std::vector<std::vector<uint8_t>> vPacked(vLevels.size());
+		uint64_t nOffset = sizeof(NativeHeader);
+		for (size_t i = 0; i < vLevels.size(); i++)
+		{
+			const uint8_t* pData = (const uint8_t*)vLevels[i].data();
+			const size_t nSize = vLevels[i].size() * sizeof(olc::Pixel);
+			if (bCompress)
+				vPacked[i] = ResourcePack::Compress(pData, nSize);
+			else
+				vPacked[i].assign(pData, pData + nSize);
+
+			header.level[i].nWidth = uint32_t(vSizes[i].x);
+			header.level[i].nHeight = uint32_t(vSizes[i].y);
+			header.level[i].nOffset = nOffset;
+			header.level[i].nSize = vPacked[i].size();
+			nOffset += vPacked[i].size();
+		}
+
+		std::ofstream ofs(sImageFile, std::ofstream::binary);
+		if (!ofs.is_open()) return olc::rcode::FAIL;
+		ofs.write((const char*)&header, sizeof(NativeHeader));
+		for (const auto& v : vPacked)
+			ofs.write((const char*)v.data(), std::streamsize(v.size()));
+		return ofs ? olc::rcode::OK : olc::rcode::FAIL;
+	}
+
+	// O------------------------------------------------------------------------------O
+	// | olc::ImageLoader IMPLEMENTATION - Encoders                                   |
+	// O------------------------------------------------------------------------------O
+	olc::rcode ImageLoader::SaveEncodedImage(const olc::Sprite* spr, const std::string& sImageFile)
+	{
+		if (spr == nullptr || spr->width <= 0 || spr->height <= 0) return olc::rcode::FAIL;
+
+		std::string sExt = _gfs::path(sImageFile).extension().string();
+		std::transform(sExt.begin(), sExt.end(), sExt.begin(), [](char c) { return char(std::tolower(c)); });
+
+		std::vector<uint8_t> vFile;
+		if (sExt == ".png") vFile = EncodePNG(spr);
+		else if (sExt == ".qoi") vFile = EncodeQOI(spr);
+		else if (sExt == ".bmp") vFile = EncodeBMP(spr);
+		else return olc::rcode::FAIL;
+
+		std::ofstream ofs(sImageFile, std::ofstream::binary);
+		if (!ofs.is_open()) return olc::rcode::FAIL;
+		ofs.write((const char*)vFile.data(), std::streamsize(vFile.size()));
+		return ofs ? olc::rcode::OK : olc::rcode::FAIL;
+	}
+
+	// Deflate with the fixed huffman codes, which saves building tables. The
+	// matching is LZ77 over a 32K window, following hash chains a little way
+	std::vector<uint8_t> ImageLoader::Deflate(const uint8_t* pData, size_t nSize)
+	{
+		static const uint16_t nLengthBase[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+		static const uint8_t nLengthExtra[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+		static const uint16_t nDistBase[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+		static const uint8_t nDistExtra[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+		std::vector<uint8_t> vOut;
+		vOut.reserve(nSize / 2 + 64);
+		uint32_t nBits = 0, nBitCount = 0;
+		auto Bits = [&](uint32_t nValue, uint32_t nCount)
+			{
+				nBits |= nValue << nBitCount;
+				nBitCount += nCount;
+				while (nBitCount >= 8)
+				{
+					vOut.push_back(uint8_t(nBits));
+					nBits >>= 8; nBitCount -= 8;
+				}
+			};
+		// Huffman codes go most significant bit first, so the fixed codes are
+		// kept reversed, ready to write
+		auto Reverse = [](uint32_t nCode, uint32_t nLength)
+			{
+				uint32_t r = 0;
+				for (uint32_t i = 0; i < nLength; i++) r |= ((nCode >> i) & 1) << (nLength - 1 - i);
+				return r;
+			};
+		struct FixedCode { uint16_t nCode; uint8_t nLength; };
+		static const std::array<FixedCode, 288> vLitCodes = [&]()
+			{
+				std::array<FixedCode, 288> t{};
+				for (uint32_t n = 0; n < 288; n++)
+				{
+					if (n < 144) t[n] = { uint16_t(Reverse(0x30 + n, 8)), 8 };
+					else if (n < 256) t[n] = { uint16_t(Reverse(0x190 + n - 144, 9)), 9 };
+					else if (n < 280) t[n] = { uint16_t(Reverse(n - 256, 7)), 7 };
+					else t[n] = { uint16_t(Reverse(0xC0 + n - 280, 8)), 8 };
+				}
+				return t;
+			}();
+		auto Symbol = [&](uint32_t n) { Bits(vLitCodes[n].nCode, vLitCodes[n].nLength); };
+
+		// One final block, fixed codes
+		Bits(1, 1); Bits(1, 2);
+
+		// Chains are cut short once a match is long enough to be worth taking
+		constexpr size_t nWindow = 32768, nHashSize = 1 << 15, nMaxChain = 16, nGoodEnough = 64;
+		std::vector<int32_t> vHead(nHashSize, -1), vPrev(nWindow, -1);
+		auto Hash = [&](size_t i) { return ((uint32_t(pData[i]) << 16 | uint32_t(pData[i + 1]) << 8 | pData[i + 2]) * 2654435761u) >> 17; };
+		auto Insert = [&](size_t i)
+			{
+				const uint32_t h = Hash(i);
+				vPrev[i % nWindow] = vHead[h];
+				vHead[h] = int32_t(i);
+			};
+
+		size_t i = 0;
+		while (i < nSize)
+		{
+			size_t nBest = 0, nBestDist = 0;
+			if (i + 3 <= nSize)
+			{
+				const size_t nMax = std::min<size_t>(258, nSize - i);
+				int32_t nCandidate = vHead[Hash(i)];
+				for (size_t c = 0; c < nMaxChain && nCandidate >= 0 && i - size_t(nCandidate) <= nWindow - 1; c++)
+				{
+					const uint8_t* a = pData + nCandidate;
+					const uint8_t* b = pData + i;
+					// Can't beat the best so far unless it matches one byte further
+					if (nBest == 0 || (nBest < nMax && a[nBest] == b[nBest]))
+					{
+						size_t n = 0;
+						while (n < nMax && a[n] == b[n]) n++;
+						if (n > nBest)
+						{
+							nBest = n; nBestDist = i - size_t(nCandidate);
+							if (n == nMax || n >= nGoodEnough) break;
+						}
+					}
+					nCandidate = vPrev[size_t(nCandidate) % nWindow];
+				}
+			}
+
+			if (nBest >= 3)
+			{
+				size_t l = 28;
+				while (nLengthBase[l] > nBest) l--;
+				Symbol(257 + uint32_t(l));
+				Bits(uint32_t(nBest - nLengthBase[l]), nLengthExtra[l]);
+				size_t d = 29;
+				while (nDistBase[d] > nBestDist) d--;
+				Bits(Reverse(uint32_t(d), 5), 5);
+				Bits(uint32_t(nBestDist - nDistBase[d]), nDistExtra[d]);
+
+				// Long runs only hash their start, which is most of the benefit
+				const size_t nEnd = i + nBest;
+				for (size_t k = 0; k < std::min<size_t>(nBest, 16) && i + k + 3 <= nSize; k++) Insert(i + k);
+				i = nEnd;
+			}
+			else
+			{
+				Symbol(pData[i]);
+				if (i + 3 <= nSize) Insert(i);
+				i++;
+			}
 		}
 
-		// Don't close base file! we will provide a stream
-		// pointer when the file is requested
-		return true;
+		Symbol(256);
+		if (nBitCount > 0) vOut.push_back(uint8_t(nBits));
+		return vOut;
 	}
 
-	bool ResourcePack::SavePack(const std::string& sFile, const std::string& sKey)
+	std::vector<uint8_t> ImageLoader::EncodePNG(const olc::Sprite* spr)
 	{
-		// Create/Overwrite the resource file
-		std::ofstream ofs(sFile, std::ofstream::binary);
-		if (!ofs.is_open()) return false;
+		const size_t w = size_t(spr->width), h = size_t(spr->height), nStride = w * 4;
+		const uint8_t* pPixels = (const uint8_t*)spr->pColData.data();
 
-		// Iterate through map
-		uint32_t nIndexSize = 0; // Unknown for now
-		ofs.write((char*)&nIndexSize, sizeof(uint32_t));
-		uint32_t nMapSize = uint32_t(mapFiles.size());
-		ofs.write((char*)&nMapSize, sizeof(uint32_t));
-		for (auto& e : mapFiles)
+		// Each row is filtered by whichever of none, sub, up or paeth looks
+		// the most compressible, going by the smallest sum of the bytes as signed
+		std::vector<uint8_t> vRaw((nStride + 1) * h);
+		std::vector<uint8_t> vTry[4];
+		for (auto& v : vTry) v.resize(nStride);
+		std::vector<uint8_t> vZero(nStride, 0);
+		for (size_t y = 0; y < h; y++)
 		{
-			// Write the path of the file
-			size_t nPathSize = e.first.size();
-			ofs.write((char*)&nPathSize, sizeof(uint32_t));
-			ofs.write(e.first.c_str(), nPathSize);
+			const uint8_t* pRow = pPixels + y * nStride;
+			const uint8_t* pUp = y > 0 ? pRow - nStride : vZero.data();
+			uint8_t* pNone = vTry[0].data();
+			uint8_t* pSub = vTry[1].data();
+			uint8_t* pUpF = vTry[2].data();
+			uint8_t* pPaeth = vTry[3].data();
+			// Sums are kept in locals, as writing bytes through the pointers
+			// would otherwise make the compiler reload them every time
+			uint32_t nSum0 = 0, nSum1 = 0, nSum2 = 0, nSum3 = 0;
+			auto Score = [](uint8_t v) { return uint32_t(v < 128 ? v : 256 - v); };
+			for (size_t x = 0; x < nStride; x++)
+			{
+				const int a = x >= 4 ? pRow[x - 4] : 0;
+				const int b = pUp[x];
+				const int c = x >= 4 ? pUp[x - 4] : 0;
+				const int p = a + b - c, pa = std::abs(p - a), pb = std::abs(p - b), pc = std::abs(p - c);
+				const int nPaeth = (pa <= pb && pa <= pc) ? a : (pb <= pc ? b : c);
+				const uint8_t v0 = pRow[x], v1 = uint8_t(v0 - a), v2 = uint8_t(v0 - b), v3 = uint8_t(v0 - nPaeth);
+				nSum0 += Score(v0); nSum1 += Score(v1); nSum2 += Score(v2); nSum3 += Score(v3);
+				pNone[x] = v0; pSub[x] = v1; pUpF[x] = v2; pPaeth[x] = v3;
+			}
 
-			// Write the file entry properties
-			ofs.write((char*)&e.second.nSize, sizeof(uint32_t));
-			ofs.write((char*)&e.second.nOffset, sizeof(uint32_t));
+			const uint32_t nSum[4] = { nSum0, nSum1, nSum2, nSum3 };
+			uint8_t* pTry[4] = { pNone, pSub, pUpF, pPaeth };
+			int nFilter = 0;
+			for (int f = 1; f < 4; f++)
+				if (nSum[f] < nSum[nFilter]) nFilter = f;
+
+			// Filter types are none 0, sub 1, up 2, paeth 4
+			uint8_t* pOut = vRaw.data() + y * (nStride + 1);
+			pOut[0] = uint8_t(nFilter == 3 ? 4 : nFilter);
+			std::memcpy(pOut + 1, pTry[nFilter], nStride);
 		}
 
-		// 2) Write the individual Data
-		std::streampos offset = ofs.tellp();
-		nIndexSize = (uint32_t)offset;
-		for (auto& e : mapFiles)
+		// zlib wrapping, a header, the deflate stream, then an adler32
+		std::vector<uint8_t> vZlib = { 0x78, 0x01 };
+		std::vector<uint8_t> vDeflate = Deflate(vRaw.data(), vRaw.size());
+		vZlib.insert(vZlib.end(), vDeflate.begin(), vDeflate.end());
+		// 5552 bytes is as many as can be summed before s2 could overflow
+		uint32_t s1 = 1, s2 = 0;
+		for (size_t i = 0; i < vRaw.size();)
 		{
-			// Store beginning of file offset within resource pack file
-			e.second.nOffset = (uint32_t)offset;
-
-			// Load the file to be added
-			std::vector<uint8_t> vBuffer(e.second.nSize);
-			std::ifstream i(e.first, std::ifstream::binary);
-			i.read((char*)vBuffer.data(), e.second.nSize);
-			i.close();
-
-			// Write the loaded file into resource pack file
-			ofs.write((char*)vBuffer.data(), e.second.nSize);
-			offset += e.second.nSize;
+			const size_t nEnd = std::min(vRaw.size(), i + 5552);
+			for (; i < nEnd; i++) { s1 += vRaw[i]; s2 += s1; }
+			s1 %= 65521; s2 %= 65521;
 		}
+		const uint32_t nAdler = (s2 << 16) | s1;
+		for (int k = 3; k >= 0; k--) vZlib.push_back(uint8_t(nAdler >> (k * 8)));
 
-		// 3) Scramble Index
-		std::vector<char> stream;
-		auto write = [&stream](const char* data, size_t size) {
-			size_t sizeNow = stream.size();
-			stream.resize(sizeNow + size);
-			memcpy(stream.data() + sizeNow, data, size);
+		std::vector<uint8_t> vOut = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+		auto BE32 = [](std::vector<uint8_t>& v, uint32_t n) { for (int k = 3; k >= 0; k--) v.push_back(uint8_t(n >> (k * 8))); };
+		auto Chunk = [&](const char* sType, const std::vector<uint8_t>& vData)
+			{
+				BE32(vOut, uint32_t(vData.size()));
+				const size_t nStart = vOut.size();
+				vOut.insert(vOut.end(), sType, sType + 4);
+				vOut.insert(vOut.end(), vData.begin(), vData.end());
+				BE32(vOut, ResourcePack::Checksum(vOut.data() + nStart, vOut.size() - nStart));
 			};
 
-		// Iterate through map
-		write((char*)&nMapSize, sizeof(uint32_t));
-		for (auto& e : mapFiles)
-		{
-			// Write the path of the file
-			size_t nPathSize = e.first.size();
-			write((char*)&nPathSize, sizeof(uint32_t));
-			write(e.first.c_str(), nPathSize);
+		std::vector<uint8_t> vHeader;
+		BE32(vHeader, uint32_t(w));
+		BE32(vHeader, uint32_t(h));
+		// 8 bits per channel, RGBA, then default compression, filtering and no interlace
+		vHeader.insert(vHeader.end(), { 8, 6, 0, 0, 0 });
+		Chunk("IHDR", vHeader);
+		Chunk("IDAT", vZlib);
+		Chunk("IEND", {});
+		return vOut;
+	}
+
+	std::vector<uint8_t> ImageLoader::EncodeQOI(const olc::Sprite* spr)
+	{
+		// See https://qoiformat.org/qoi-specification.pdf
+		const size_t nPixels = spr->pColData.size();
+		std::vector<uint8_t> vOut;
+		vOut.reserve(14 + nPixels * 5 + 8);
+		vOut.insert(vOut.end(), { 'q', 'o', 'i', 'f' });
+		for (uint32_t n : { uint32_t(spr->width), uint32_t(spr->height) })
+			for (int k = 3; k >= 0; k--) vOut.push_back(uint8_t(n >> (k * 8)));
+		// RGBA, sRGB with linear alpha
+		vOut.push_back(4); vOut.push_back(0);
+
+		olc::Pixel vSeen[64];
+		std::fill_n(vSeen, 64, olc::Pixel(0, 0, 0, 0));
+		olc::Pixel pPrev(0, 0, 0, 255);
+		uint32_t nRun = 0;
+
+		for (size_t i = 0; i < nPixels; i++)
+		{
+			const olc::Pixel p = spr->pColData[i];
+			if (p == pPrev)
+			{
+				nRun++;
+				if (nRun == 62 || i == nPixels - 1)
+				{
+					vOut.push_back(uint8_t(0xC0 | (nRun - 1)));
+					nRun = 0;
+				}
+				continue;
+			}
 
-			// Write the file entry properties
-			write((char*)&e.second.nSize, sizeof(uint32_t));
-			write((char*)&e.second.nOffset, sizeof(uint32_t));
+			if (nRun > 0)
+			{
+				vOut.push_back(uint8_t(0xC0 | (nRun - 1)));
+				nRun = 0;
+			}
+
+			const uint32_t nHash = (p.r * 3 + p.g * 5 + p.b * 7 + p.a * 11) % 64;
+			if (vSeen[nHash] == p)
+				vOut.push_back(uint8_t(nHash));
+			else
+			{
+				vSeen[nHash] = p;
+				if (p.a == pPrev.a)
+				{
+					const int8_t dr = int8_t(p.r - pPrev.r), dg = int8_t(p.g - pPrev.g), db = int8_t(p.b - pPrev.b);
+					const int8_t dgr = int8_t(dr - dg), dgb = int8_t(db - dg);
+					if (dr >= -2 && dr <= 1 && dg >= -2 && dg <= 1 && db >= -2 && db <= 1)
+						vOut.push_back(uint8_t(0x40 | (dr + 2) << 4 | (dg + 2) << 2 | (db + 2)));
+					else if (dgr >= -8 && dgr <= 7 && dg >= -32 && dg <= 31 && dgb >= -8 && dgb <= 7)
+					{
+						vOut.push_back(uint8_t(0x80 | (dg + 32)));
+						vOut.push_back(uint8_t((dgr + 8) << 4 | (dgb + 8)));
+					}
+					else
+						vOut.insert(vOut.end(), { 0xFE, p.r, p.g, p.b });
+				}
+				else
+					vOut.insert(vOut.end(), { 0xFF, p.r, p.g, p.b, p.a });
+			}
+			pPrev = p;
 		}
-		std::vector<char> sIndexString = scramble(stream, sKey);
-		uint32_t nIndexStringLen = uint32_t(sIndexString.size());
-		// 4) Rewrite Map (it has been updated with offsets now)
-		// at start of file
-		ofs.seekp(0, std::ios::beg);
-		ofs.write((char*)&nIndexStringLen, sizeof(uint32_t));
-		ofs.write(sIndexString.data(), nIndexStringLen);
-		ofs.close();
-		return true;
-	}
 
-	ResourceBuffer ResourcePack::GetFileBuffer(const std::string& sFile)
-	{
-		return ResourceBuffer(baseFile, mapFiles[sFile].nOffset, mapFiles[sFile].nSize);
+		vOut.insert(vOut.end(), { 0, 0, 0, 0, 0, 0, 0, 1 });
+		return vOut;
 	}
 
-	bool ResourcePack::Loaded()
+	std::vector<uint8_t> ImageLoader::EncodeBMP(const olc::Sprite* spr)
 	{
-		return baseFile.is_open();
-	}
+		// 32 bit BGRA, rows bottom up, which everything reads
+		const uint32_t w = uint32_t(spr->width), h = uint32_t(spr->height);
+		const uint32_t nImageSize = w * h * 4, nHeaderSize = 14 + 40;
+		std::vector<uint8_t> vOut;
+		vOut.reserve(nHeaderSize + nImageSize);
+		auto LE = [&](uint32_t n, int nBytes) { for (int k = 0; k < nBytes; k++) vOut.push_back(uint8_t(n >> (k * 8))); };
 
-	std::vector<char> ResourcePack::scramble(const std::vector<char>& data, const std::string& key)
-	{
-		if (key.empty()) return data;
-		std::vector<char> o;
-		size_t c = 0;
-		for (auto s : data)	o.push_back(s ^ key[(c++) % key.size()]);
-		return o;
-	};
+		vOut.push_back('B'); vOut.push_back('M');
+		LE(nHeaderSize + nImageSize, 4); LE(0, 4); LE(nHeaderSize, 4);
+		LE(40, 4); LE(w, 4); LE(h, 4); LE(1, 2); LE(32, 2);
+		LE(0, 4); LE(nImageSize, 4); LE(2835, 4); LE(2835, 4); LE(0, 4); LE(0, 4);
 
-	std::string ResourcePack::makeposix(const std::string& path)
-	{
-		std::string o;
-		for (auto s : path) o += std::string(1, s == '\\' ? '/' : s);
-		return o;
-	};
+		for (uint32_t y = h; y-- > 0;)
+		{
+			const olc::Pixel* pRow = spr->pColData.data() + size_t(y) * w;
+			for (uint32_t x = 0; x < w; x++)
+				vOut.insert(vOut.end(), { pRow[x].b, pRow[x].g, pRow[x].r, pRow[x].a });
+		}
+		return vOut;
+	}
 
 	// O------------------------------------------------------------------------------O
 	// | olc::PixelGameEngine IMPLEMENTATION                                          |
@@ -2498,6 +4860,11 @@ namespace olc
 		return pDrawTarget;
 	}
 
+	uint8_t PixelGameEngine::GetDrawTargetLayer() const
+	{
+		return nTargetLayer;
+	}
+
 	int32_t PixelGameEngine::GetDrawTargetWidth() const
 	{
 		if (pDrawTarget)
@@ -2519,6 +4886,16 @@ namespace olc
 		return nLastFPS;
 	}
 
+	olc::RendererStats PixelGameEngine::GetRendererStats() const
+	{
+		return renderer->GetStats();
+	}
+
+	olc::Profiler& PixelGameEngine::GetProfiler()
+	{
+		return profiler;
+	}
+
 	bool PixelGameEngine::IsFocused() const
 	{
 		return bHasInputFocus;
@@ -2569,6 +4946,39 @@ namespace olc
 		return fLastElapsed;
 	}
 
+	void PixelGameEngine::SetFrameRateLimit(const float fFramesPerSecond)
+	{
+		if (fFramesPerSecond > 0.0f)
+			m_durFramePeriod = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(1.0 / fFramesPerSecond));
+		else
+			m_durFramePeriod = std::chrono::steady_clock::duration::zero();
+		m_tpNextFrame = std::chrono::steady_clock::now();
+	}
+
+	float PixelGameEngine::GetFrameRateLimit() const
+	{
+		if (m_durFramePeriod.count() == 0) return 0.0f;
+		return float(1.0 / std::chrono::duration<double>(m_durFramePeriod).count());
+	}
+
+	void PixelGameEngine::SetFixedUpdateRate(const float fUpdatesPerSecond, const uint32_t nMaxStepsPerFrame)
+	{
+		fFixedStep = fUpdatesPerSecond > 0.0f ? 1.0f / fUpdatesPerSecond : 0.0f;
+		nFixedMaxSteps = std::max(nMaxStepsPerFrame, 1u);
+		fFixedAccumulator = 0.0f;
+		fFixedAlpha = 0.0f;
+	}
+
+	float PixelGameEngine::GetFixedUpdateRate() const
+	{
+		return fFixedStep > 0.0f ? 1.0f / fFixedStep : 0.0f;
+	}
+
+	float PixelGameEngine::GetFixedUpdateAlpha() const
+	{
+		return fFixedAlpha;
+	}
+
 	const olc::vi2d& PixelGameEngine::GetWindowSize() const
 	{
 		return vWindowSize;
@@ -2608,37 +5018,55 @@ namespace olc
 	bool PixelGameEngine::Draw(int32_t x, int32_t y, Pixel p)
 	{
 		if (!pDrawTarget) return false;
+		if (x < 0 || x >= pDrawTarget->width || y < 0 || y >= pDrawTarget->height) return false;
+		if (nPixelMode == Pixel::MASK && p.a != 255) return false;
 
-		if (nPixelMode == Pixel::NORMAL)
-		{
-			return pDrawTarget->SetPixel(x, y, p);
-		}
+		pDrawTarget->MarkDirty(x, y, x, y);
+		Pixel& d = pDrawTarget->pColData[size_t(y) * pDrawTarget->width + x];
 
-		if (nPixelMode == Pixel::MASK)
-		{
-			if (p.a == 255)
-				return pDrawTarget->SetPixel(x, y, p);
-		}
+		if (nPixelMode == Pixel::CUSTOM)
+			d = funcPixelMode(x, y, p, d);
+		else if (nPixelMode == Pixel::ALPHA)
+			d = PixelBlend(d, p, nBlendFactor);
+		else
+			d = p;
+		return true;
+	}
 
-		if (nPixelMode == Pixel::ALPHA)
-		{
-			Pixel d = pDrawTarget->GetPixel(x, y);
-			float a = (float)(p.a / 255.0f) * fBlendFactor;
-			float c = 1.0f - a;
-			float r = a * (float)p.r + c * (float)d.r;
-			float g = a * (float)p.g + c * (float)d.g;
-			float b = a * (float)p.b + c * (float)d.b;
-			return pDrawTarget->SetPixel(x, y, Pixel((uint8_t)r, (uint8_t)g, (uint8_t)b/*, (uint8_t)(p.a * fBlendFactor)*/));
-		}
+	void PixelGameEngine::SpanFill(int32_t x1, int32_t x2, int32_t y, Pixel p)
+	{
+		if (!pDrawTarget || y < 0 || y >= pDrawTarget->height) return;
+		if (x1 < 0) x1 = 0;
+		if (x2 >= pDrawTarget->width) x2 = pDrawTarget->width - 1;
+		if (x1 > x2) return;
+		if (nPixelMode == Pixel::MASK && p.a != 255) return;
 
-		if (nPixelMode == Pixel::CUSTOM)
-		{
-			return pDrawTarget->SetPixel(x, y, funcPixelMode(x, y, p, pDrawTarget->GetPixel(x, y)));
-		}
+		pDrawTarget->MarkDirty(x1, y, x2, y);
+		Pixel* pRow = pDrawTarget->pColData.data() + size_t(y) * pDrawTarget->width;
 
-		return false;
+		if (nPixelMode == Pixel::CUSTOM)
+			for (int32_t x = x1; x <= x2; x++)
+				pRow[x] = funcPixelMode(x, y, p, pRow[x]);
+		else
+			SpanWrite(pRow + x1, nullptr, p, size_t(x2 - x1 + 1), nPixelMode, nBlendFactor);
 	}
 
+	void PixelGameEngine::SpanCopy(int32_t x, int32_t y, const Pixel* pSrc, int32_t nLen)
+	{
+		if (!pDrawTarget || y < 0 || y >= pDrawTarget->height) return;
+		if (x < 0) { pSrc -= x; nLen += x; x = 0; }
+		if (x + nLen > pDrawTarget->width) nLen = pDrawTarget->width - x;
+		if (nLen <= 0) return;
+
+		pDrawTarget->MarkDirty(x, y, x + nLen - 1, y);
+		Pixel* pDst = pDrawTarget->pColData.data() + size_t(y) * pDrawTarget->width + x;
+
+		if (nPixelMode == Pixel::CUSTOM)
+			for (int32_t i = 0; i < nLen; i++)
+				pDst[i] = funcPixelMode(x + i, y, pSrc[i], pDst[i]);
+		else
+			SpanWrite(pDst, pSrc, Pixel(), size_t(nLen), nPixelMode, nBlendFactor);
+	}
 
 	void PixelGameEngine::DrawLine(const olc::vi2d& pos1, const olc::vi2d& pos2, Pixel p, uint32_t pattern)
 	{
@@ -2647,7 +5075,12 @@ namespace olc
 
 	void PixelGameEngine::DrawLine(int32_t x1, int32_t y1, int32_t x2, int32_t y2, Pixel p, uint32_t pattern)
 	{
-		int x, y, dx, dy, dx1, dy1, px, py, xe, ye, i;
+		LineWalk(x1, y1, x2, y2, p, pattern, false);
+	}
+
+	void PixelGameEngine::LineWalk(int32_t x1, int32_t y1, int32_t x2, int32_t y2, Pixel p, uint32_t& pattern, bool bSkipFirst)
+	{
+		int x, y, dx, dy, dx1, dy1, xe, ye;
 		dx = x2 - x1; dy = y2 - y1;
 
 		auto rol = [&](void) { pattern = (pattern << 1) | (pattern >> 31); return pattern & 1; };
@@ -2655,79 +5088,199 @@ namespace olc
 		olc::vi2d p1(x1, y1), p2(x2, y2);
 		if (!ClipLineToScreen(p1, p2))
 			return;
+
+		// Joined lines only leave out their first pixel if it survived clipping
+		bSkipFirst = bSkipFirst && p1 == olc::vi2d(x1, y1);
 		x1 = p1.x; y1 = p1.y;
 		x2 = p2.x; y2 = p2.y;
 
-		// straight lines idea by gurkanctn
-		if (dx == 0) // Line is vertical
+		if (!pDrawTarget) return;
+		if (nPixelMode == Pixel::MASK && p.a != 255) return;
+		const bool bSolid = pattern == 0xFFFFFFFF;
+
+		// Straight, solid lines are just a span, straight lines idea by gurkanctn
+		if (dy == 0 && bSolid && !bSkipFirst)
 		{
-			if (y2 < y1) std::swap(y1, y2);
-			for (y = y1; y <= y2; y++) if (rol()) Draw(x1, y, p);
+			SpanFill(std::min(x1, x2), std::max(x1, x2), y1, p);
 			return;
 		}
 
-		if (dy == 0) // Line is horizontal
+		// Line is Funk-aye. Walk it from the end with the smallest major
+		// coordinate, stepping the minor axis whenever the error term allows.
+		// Lines that are exactly vertical or horizontal never step it at all
+		dx1 = abs(dx); dy1 = abs(dy);
+		const bool bXMajor = dy1 <= dx1;
+		const bool bReverse = bXMajor ? dx < 0 : dy < 0;
+		int nErr, nErrInc, nErrDec, nSteps;
+		if (bXMajor)
 		{
-			if (x2 < x1) std::swap(x1, x2);
-			for (x = x1; x <= x2; x++) if (rol()) Draw(x, y1, p);
-			return;
+			x = bReverse ? x2 : x1; y = bReverse ? y2 : y1; xe = bReverse ? x1 : x2;
+			nSteps = xe - x;
+			nErr = 2 * dy1 - dx1; nErrInc = 2 * dy1; nErrDec = 2 * (dy1 - dx1);
+		}
+		else
+		{
+			x = bReverse ? x2 : x1; y = bReverse ? y2 : y1; ye = bReverse ? y1 : y2;
+			nSteps = ye - y;
+			nErr = 2 * dx1 - dy1 - 1; nErrInc = 2 * dx1; nErrDec = 2 * (dx1 - dy1);
 		}
+		const int nMinor = ((dx < 0 && dy < 0) || (dx > 0 && dy > 0)) ? 1 : -1;
 
-		// Line is Funk-aye
-		dx1 = abs(dx); dy1 = abs(dy);
-		px = 2 * dy1 - dx1;	py = 2 * dx1 - dy1;
-		if (dy1 <= dx1)
+		// Pixel i of the walk that belongs to (x1,y1), if it is to be left out
+		const int nSkip = !bSkipFirst ? -1 : (bReverse ? std::max(nSteps, 0) : 0);
+
+		auto step = [&]()
 		{
-			if (dx >= 0)
-			{
-				x = x1; y = y1; xe = x2;
-			}
+			if (bXMajor) x++; else y++;
+			if (nErr < 0)
+				nErr += nErrInc;
 			else
 			{
-				x = x2; y = y2; xe = x1;
+				if (bXMajor) y += nMinor; else x += nMinor;
+				nErr += nErrDec;
 			}
+		};
+
+		if (nPixelMode == Pixel::CUSTOM)
+		{
+			for (int i = 0; i <= nSteps; i++, step())
+				if (rol() && i != nSkip) Draw(x, y, p);
+			return;
+		}
+
+		// Both coordinates only ever move one way, so the pixels on the target
+		// are a single run. Walk up to it, then step a pointer through memory
+		// until the line leaves the target again
+		const int32_t nW = pDrawTarget->width, nH = pDrawTarget->height;
+		auto inside = [&]() { return uint32_t(x) < uint32_t(nW) && uint32_t(y) < uint32_t(nH); };
+		int i = 0;
+		for (; i <= nSteps && !inside(); i++, step()) rol();
+		if (i > nSteps) return;
+		pDrawTarget->MarkDirty(std::min(x1, x2), std::min(y1, y2), std::max(x1, x2), std::max(y1, y2));
+
+		const int nLast = std::min(nSteps, i + (bXMajor ? nW - 1 - x : nH - 1 - y));
+		const ptrdiff_t nMajorStride = bXMajor ? 1 : nW;
+		const ptrdiff_t nMinorStride = bXMajor ? nMinor * ptrdiff_t(nW) : nMinor;
+		int32_t nMinorPos = bXMajor ? y : x;
+		const uint32_t nMinorLimit = uint32_t(bXMajor ? nH : nW);
+		Pixel* pDst = pDrawTarget->pColData.data() + size_t(y) * nW + x;
 
-			if (rol()) Draw(x, y, p);
+		// A solid pattern ends each rotation where it started, so with nothing
+		// to skip every pixel is plotted and the rotation can go
+		const bool bEvery = bSolid && nSkip < 0;
 
-			for (i = 0; x < xe; i++)
+		auto walk = [&](auto plot)
+		{
+			for (;; i++)
 			{
-				x = x + 1;
-				if (px < 0)
-					px = px + 2 * dy1;
+				if (bEvery || (rol() && i != nSkip)) plot(*pDst);
+				if (i == nLast) break;
+				pDst += nMajorStride;
+				if (nErr < 0)
+					nErr += nErrInc;
 				else
 				{
-					if ((dx < 0 && dy < 0) || (dx > 0 && dy > 0)) y = y + 1; else y = y - 1;
-					px = px + 2 * (dy1 - dx1);
+					nErr += nErrDec;
+					nMinorPos += nMinor;
+					if (uint32_t(nMinorPos) >= nMinorLimit) break;
+					pDst += nMinorStride;
 				}
-				if (rol()) Draw(x, y, p);
 			}
+		};
+
+		if (nPixelMode == Pixel::ALPHA)
+		{
+			const uint8_t nBlend = nBlendFactor;
+			walk([&](Pixel& d) { d = PixelBlend(d, p, nBlend); });
 		}
 		else
+			walk([&](Pixel& d) { d = p; });
+	}
+
+	void PixelGameEngine::DrawLines(const std::vector<olc::vi2d>& vPoints, Pixel p, uint32_t pattern, olc::DecalStructure structure)
+	{
+		DrawLines(vPoints.data(), vPoints.size(), p, pattern, structure);
+	}
+
+	void PixelGameEngine::DrawLines(const olc::vi2d* pPoints, size_t nPoints, Pixel p, uint32_t pattern, olc::DecalStructure structure)
+	{
+		if (structure == olc::DecalStructure::STRIP)
 		{
-			if (dy >= 0)
-			{
-				x = x1; y = y1; ye = y2;
-			}
-			else
-			{
-				x = x2; y = y2; ye = y1;
-			}
+			if (nPoints == 1) LineWalk(pPoints[0].x, pPoints[0].y, pPoints[0].x, pPoints[0].y, p, pattern, false);
+			for (size_t i = 1; i < nPoints; i++)
+				LineWalk(pPoints[i - 1].x, pPoints[i - 1].y, pPoints[i].x, pPoints[i].y, p, pattern, i > 1);
+			return;
+		}
+
+		if (structure == olc::DecalStructure::FAN)
+		{
+			for (size_t i = 1; i < nPoints; i++)
+				LineWalk(pPoints[0].x, pPoints[0].y, pPoints[i].x, pPoints[i].y, p, pattern, i > 1);
+			return;
+		}
 
-			if (rol()) Draw(x, y, p);
+		// LIST or LINE, separate lines
+		for (size_t i = 1; i < nPoints; i += 2)
+			LineWalk(pPoints[i - 1].x, pPoints[i - 1].y, pPoints[i].x, pPoints[i].y, p, pattern, false);
+	}
+
+	void PixelGameEngine::DrawLineAA(const olc::vf2d& pos1, const olc::vf2d& pos2, Pixel p)
+	{
+		// Xiaolin Wu's line, coverage of the two pixels straddling the line at
+		// each step scales the alpha of the colour being blended in
+		if (!pDrawTarget || nPixelMode == Pixel::MASK) return;
+
+		float x1 = pos1.x, y1 = pos1.y, x2 = pos2.x, y2 = pos2.y;
+		const bool bSteep = std::abs(y2 - y1) > std::abs(x2 - x1);
+		if (bSteep) { std::swap(x1, y1); std::swap(x2, y2); }
+		if (x1 > x2) { std::swap(x1, x2); std::swap(y1, y2); }
+
+		const float fGradient = (x2 - x1) == 0.0f ? 1.0f : (y2 - y1) / (x2 - x1);
+		const int32_t nMajorSize = bSteep ? pDrawTarget->height : pDrawTarget->width;
+		const int32_t nMinorSize = bSteep ? pDrawTarget->width : pDrawTarget->height;
+
+		const Pixel::Mode nMode = nPixelMode;
+		if (nMode != Pixel::CUSTOM) nPixelMode = Pixel::ALPHA;
+
+		auto plot = [&](int32_t a, int32_t b, float fCoverage)
+		{
+			if (uint32_t(b) >= uint32_t(nMinorSize)) return;
+			const uint8_t nAlpha = uint8_t(float(p.a) * std::min(fCoverage, 1.0f) + 0.5f);
+			if (nAlpha == 0) return;
+			if (bSteep) Draw(b, a, Pixel(p.r, p.g, p.b, nAlpha));
+			else Draw(a, b, Pixel(p.r, p.g, p.b, nAlpha));
+		};
+
+		auto fpart = [](float f) { return f - std::floor(f); };
 
-			for (i = 0; y < ye; i++)
+		// End points are weighted by how much of their pixel the line spans
+		auto endpoint = [&](float fx, float fy, float fGap)
+		{
+			const int32_t nx = int32_t(std::round(fx));
+			const float fEnd = fy + fGradient * (float(nx) - fx);
+			const int32_t ny = int32_t(std::floor(fEnd));
+			if (uint32_t(nx) < uint32_t(nMajorSize))
 			{
-				y = y + 1;
-				if (py <= 0)
-					py = py + 2 * dx1;
-				else
-				{
-					if ((dx < 0 && dy < 0) || (dx > 0 && dy > 0)) x = x + 1; else x = x - 1;
-					py = py + 2 * (dx1 - dy1);
-				}
-				if (rol()) Draw(x, y, p);
+				plot(nx, ny, (1.0f - fpart(fEnd)) * fGap);
+				plot(nx, ny + 1, fpart(fEnd) * fGap);
 			}
+			return nx;
+		};
+
+		const int32_t nStart = endpoint(x1, y1, 1.0f - fpart(x1 + 0.5f));
+		const int32_t nEnd = endpoint(x2, y2, fpart(x2 + 0.5f));
+
+		// Only walk the part of the line that lies over the target
+		const int32_t nFrom = std::max(nStart + 1, 0), nTo = std::min(nEnd - 1, nMajorSize - 1);
+		float fInter = y1 + fGradient * (float(nFrom) - x1);
+		for (int32_t n = nFrom; n <= nTo; n++, fInter += fGradient)
+		{
+			const int32_t nb = int32_t(std::floor(fInter));
+			plot(n, nb, 1.0f - fpart(fInter));
+			plot(n, nb + 1, fpart(fInter));
 		}
+
+		nPixelMode = nMode;
 	}
 
 	void PixelGameEngine::DrawCircle(const olc::vi2d& pos, int32_t radius, Pixel p, uint8_t mask)
@@ -2746,25 +5299,72 @@ namespace olc
 			int y0 = radius;
 			int d = 3 - 2 * radius;
 
+			// Wholly on target with nothing to blend, so plot straight into memory
+			const int32_t nW = pDrawTarget ? pDrawTarget->width : 0;
+			if (x >= radius && y >= radius && x + radius < nW && y + radius < GetDrawTargetHeight()
+				&& nPixelMode == Pixel::NORMAL)
+			{
+				pDrawTarget->MarkDirty(x - radius, y - radius, x + radius, y + radius);
+				Pixel* pC = pDrawTarget->pColData.data() + size_t(y) * nW + x;
+				while (y0 >= x0)
+				{
+					const int32_t rx0 = x0 * nW, ry0 = y0 * nW;
+					if (mask & 0x01) pC[x0 - ry0] = p;
+					if (mask & 0x04) pC[y0 + rx0] = p;
+					if (mask & 0x10) pC[-x0 + ry0] = p;
+					if (mask & 0x40) pC[-y0 - rx0] = p;
+					if (x0 != 0 && x0 != y0)
+					{
+						if (mask & 0x02) pC[y0 - rx0] = p;
+						if (mask & 0x08) pC[x0 + ry0] = p;
+						if (mask & 0x20) pC[-y0 + rx0] = p;
+						if (mask & 0x80) pC[-x0 - ry0] = p;
+					}
+
+					if (d < 0)
+						d += 4 * x0++ + 6;
+					else
+						d += 4 * (x0++ - y0--) + 10;
+				}
+				return;
+			}
+
+			// The octants either side of the vertical axis step along rows, so
+			// their pixels are gathered into runs and drawn as spans, the other
+			// four only ever put one pixel on a row
+			int nRunStart = 0;
 			while (y0 >= x0) // only formulate 1/8 of circle
 			{
-				// Draw even octants
-				if (mask & 0x01) Draw(x + x0, y - y0, p);// Q6 - upper right right
+				// Octants that step down columns, one pixel per row
 				if (mask & 0x04) Draw(x + y0, y + x0, p);// Q4 - lower lower right
-				if (mask & 0x10) Draw(x - x0, y + y0, p);// Q2 - lower left left
 				if (mask & 0x40) Draw(x - y0, y - x0, p);// Q0 - upper upper left
 				if (x0 != 0 && x0 != y0)
 				{
 					if (mask & 0x02) Draw(x + y0, y - x0, p);// Q7 - upper upper right
-					if (mask & 0x08) Draw(x + x0, y + y0, p);// Q5 - lower right right
 					if (mask & 0x20) Draw(x - y0, y + x0, p);// Q3 - lower lower left
-					if (mask & 0x80) Draw(x - x0, y - y0, p);// Q1 - upper left left
 				}
 
+				const int nRunEnd = x0, nRow = y0;
 				if (d < 0)
 					d += 4 * x0++ + 6;
 				else
 					d += 4 * (x0++ - y0--) + 10;
+
+				// Row is about to change, or circle is done, so draw the run
+				if (y0 != nRow || y0 < x0)
+				{
+					if (mask & 0x01) SpanFill(x + nRunStart, x + nRunEnd, y - nRow, p);// Q6 - upper right right
+					if (mask & 0x10) SpanFill(x - nRunEnd, x - nRunStart, y + nRow, p);// Q2 - lower left left
+
+					// These two skip x0 == 0 and x0 == y0, as above
+					const int nA = std::max(nRunStart, 1), nB = nRunEnd == nRow ? nRunEnd - 1 : nRunEnd;
+					if (nA <= nB)
+					{
+						if (mask & 0x08) SpanFill(x + nA, x + nB, y + nRow, p);// Q5 - lower right right
+						if (mask & 0x80) SpanFill(x - nB, x - nA, y - nRow, p);// Q1 - upper left left
+					}
+					nRunStart = x0;
+				}
 			}
 		}
 		else
@@ -2787,16 +5387,10 @@ namespace olc
 			int y0 = radius;
 			int d = 3 - 2 * radius;
 
-			auto drawline = [&](int sx, int ex, int y)
-				{
-					for (int x = sx; x <= ex; x++)
-						Draw(x, y, p);
-				};
-
 			while (y0 >= x0)
 			{
-				drawline(x - y0, x + y0, y - x0);
-				if (x0 > 0)	drawline(x - y0, x + y0, y + x0);
+				SpanFill(x - y0, x + y0, y - x0, p);
+				if (x0 > 0)	SpanFill(x - y0, x + y0, y + x0, p);
 
 				if (d < 0)
 					d += 4 * x0++ + 6;
@@ -2804,8 +5398,8 @@ namespace olc
 				{
 					if (x0 != y0)
 					{
-						drawline(x - x0, x + x0, y - y0);
-						drawline(x - x0, x + x0, y + y0);
+						SpanFill(x - x0, x + x0, y - y0, p);
+						SpanFill(x - x0, x + x0, y + y0, p);
 					}
 					d += 4 * (x0++ - y0--) + 10;
 				}
@@ -2815,6 +5409,73 @@ namespace olc
 			Draw(x, y, p);
 	}
 
+	template<typename F>
+	void PixelGameEngine::RasterEllipse(int32_t rx, int32_t ry, F&& emit)
+	{
+		// A row covers every pixel centre inside the ellipse with radii grown
+		// by half a pixel, tested in doubled integer coordinates
+		const int64_t nA = int64_t(2 * rx + 1) * (2 * rx + 1);
+		const int64_t nB = int64_t(2 * ry + 1) * (2 * ry + 1);
+		auto inside = [&](int64_t dx, int64_t dy) { return 4 * dx * dx * nB + 4 * dy * dy * nA <= nA * nB; };
+
+		// Half widths only shrink moving away from the centre row
+		int32_t nOuter = rx;
+		for (int32_t dy = 0; dy <= ry; dy++)
+		{
+			int32_t nInner = nOuter;
+			while (nInner >= 0 && !inside(nInner, dy + 1)) nInner--;
+			emit(dy, nInner, nOuter);
+			nOuter = nInner;
+		}
+	}
+
+	void PixelGameEngine::DrawEllipse(const olc::vi2d& pos, const olc::vi2d& radius, Pixel p)
+	{
+		DrawEllipse(pos.x, pos.y, radius.x, radius.y, p);
+	}
+
+	void PixelGameEngine::DrawEllipse(int32_t x, int32_t y, int32_t rx, int32_t ry, Pixel p)
+	{
+		if (rx < 0 || ry < 0 || x < -rx || y < -ry || x - GetDrawTargetWidth() > rx || y - GetDrawTargetHeight() > ry)
+			return;
+
+		RasterEllipse(rx, ry, [&](int32_t dy, int32_t nInner, int32_t nOuter)
+			{
+				// The outline is whatever part of the row the next row out does not cover
+				const int32_t nStart = std::min(nInner + 1, nOuter);
+				auto row = [&](int32_t ny)
+				{
+					if (nStart == 0)
+						SpanFill(x - nOuter, x + nOuter, ny, p);
+					else
+					{
+						SpanFill(x - nOuter, x - nStart, ny, p);
+						SpanFill(x + nStart, x + nOuter, ny, p);
+					}
+				};
+
+				row(y - dy);
+				if (dy > 0) row(y + dy);
+			});
+	}
+
+	void PixelGameEngine::FillEllipse(const olc::vi2d& pos, const olc::vi2d& radius, Pixel p)
+	{
+		FillEllipse(pos.x, pos.y, radius.x, radius.y, p);
+	}
+
+	void PixelGameEngine::FillEllipse(int32_t x, int32_t y, int32_t rx, int32_t ry, Pixel p)
+	{
+		if (rx < 0 || ry < 0 || x < -rx || y < -ry || x - GetDrawTargetWidth() > rx || y - GetDrawTargetHeight() > ry)
+			return;
+
+		RasterEllipse(rx, ry, [&](int32_t dy, int32_t, int32_t nOuter)
+			{
+				SpanFill(x - nOuter, x + nOuter, y - dy, p);
+				if (dy > 0) SpanFill(x - nOuter, x + nOuter, y + dy, p);
+			});
+	}
+
 	void PixelGameEngine::DrawRect(const olc::vi2d& pos, const olc::vi2d& size, Pixel p)
 	{
 		DrawRect(pos.x, pos.y, size.x, size.y, p);
@@ -2830,9 +5491,9 @@ namespace olc
 
 	void PixelGameEngine::Clear(Pixel p)
 	{
-		int pixels = GetDrawTargetWidth() * GetDrawTargetHeight();
-		Pixel* m = GetDrawTarget()->GetData();
-		for (int i = 0; i < pixels; i++) m[i] = p;
+		if (!pDrawTarget) return;
+		pDrawTarget->MarkDirty();
+		std::fill(pDrawTarget->pColData.begin(), pDrawTarget->pColData.end(), p);
 	}
 
 	void PixelGameEngine::ClearBuffer(Pixel p, bool bDepth)
@@ -2891,22 +5552,27 @@ namespace olc
 
 	void PixelGameEngine::FillRect(int32_t x, int32_t y, int32_t w, int32_t h, Pixel p)
 	{
+		if (!pDrawTarget) return;
+
 		int32_t x2 = x + w;
 		int32_t y2 = y + h;
 
-		if (x < 0) x = 0;
-		if (x >= (int32_t)GetDrawTargetWidth()) x = (int32_t)GetDrawTargetWidth();
-		if (y < 0) y = 0;
-		if (y >= (int32_t)GetDrawTargetHeight()) y = (int32_t)GetDrawTargetHeight();
+		// Clip once, then work in rows
+		x = std::max(x, 0); x2 = std::min(x2, pDrawTarget->width);
+		y = std::max(y, 0); y2 = std::min(y2, pDrawTarget->height);
+		if (x >= x2 || y >= y2) return;
 
-		if (x2 < 0) x2 = 0;
-		if (x2 >= (int32_t)GetDrawTargetWidth()) x2 = (int32_t)GetDrawTargetWidth();
-		if (y2 < 0) y2 = 0;
-		if (y2 >= (int32_t)GetDrawTargetHeight()) y2 = (int32_t)GetDrawTargetHeight();
+		// Opaque rectangles spanning the full target width are one contiguous block
+		if (x == 0 && x2 == pDrawTarget->width && (nPixelMode == Pixel::NORMAL || (nPixelMode == Pixel::MASK && p.a == 255)))
+		{
+			pDrawTarget->MarkDirty(0, y, x2 - 1, y2 - 1);
+			auto it = pDrawTarget->pColData.begin();
+			std::fill(it + size_t(y) * x2, it + size_t(y2) * x2, p);
+			return;
+		}
 
-		for (int i = x; i < x2; i++)
-			for (int j = y; j < y2; j++)
-				Draw(i, j, p);
+		for (int32_t j = y; j < y2; j++)
+			SpanFill(x, x2 - 1, j, p);
 	}
 
 	void PixelGameEngine::DrawTriangle(const olc::vi2d& pos1, const olc::vi2d& pos2, const olc::vi2d& pos3, Pixel p)
@@ -2914,311 +5580,286 @@ namespace olc
 		DrawTriangle(pos1.x, pos1.y, pos2.x, pos2.y, pos3.x, pos3.y, p);
 	}
 
-	void PixelGameEngine::DrawTriangle(int32_t x1, int32_t y1, int32_t x2, int32_t y2, int32_t x3, int32_t y3, Pixel p)
-	{
-		DrawLine(x1, y1, x2, y2, p);
-		DrawLine(x2, y2, x3, y3, p);
-		DrawLine(x3, y3, x1, y1, p);
-	}
-
-	void PixelGameEngine::FillTriangle(const olc::vi2d& pos1, const olc::vi2d& pos2, const olc::vi2d& pos3, Pixel p)
-	{
-		FillTriangle(pos1.x, pos1.y, pos2.x, pos2.y, pos3.x, pos3.y, p);
-	}
-
-	// https://www.avrfreaks.net/sites/default/files/triangles.c
-	void PixelGameEngine::FillTriangle(int32_t x1, int32_t y1, int32_t x2, int32_t y2, int32_t x3, int32_t y3, Pixel p)
-	{
-		auto drawline = [&](int sx, int ex, int ny) { for (int i = sx; i <= ex; i++) Draw(i, ny, p); };
-
-		int t1x, t2x, y, minx, maxx, t1xp, t2xp;
-		bool changed1 = false;
-		bool changed2 = false;
-		int signx1, signx2, dx1, dy1, dx2, dy2;
-		int e1, e2;
-		// Sort vertices
-		if (y1 > y2) { std::swap(y1, y2); std::swap(x1, x2); }
-		if (y1 > y3) { std::swap(y1, y3); std::swap(x1, x3); }
-		if (y2 > y3) { std::swap(y2, y3); std::swap(x2, x3); }
-
-		t1x = t2x = x1; y = y1;   // Starting points
-		dx1 = (int)(x2 - x1);
-		if (dx1 < 0) { dx1 = -dx1; signx1 = -1; }
-		else signx1 = 1;
-		dy1 = (int)(y2 - y1);
-
-		dx2 = (int)(x3 - x1);
-		if (dx2 < 0) { dx2 = -dx2; signx2 = -1; }
-		else signx2 = 1;
-		dy2 = (int)(y3 - y1);
-
-		if (dy1 > dx1) { std::swap(dx1, dy1); changed1 = true; }
-		if (dy2 > dx2) { std::swap(dy2, dx2); changed2 = true; }
-
-		e2 = (int)(dx2 >> 1);
-		// Flat top, just process the second half
-		if (y1 == y2) goto next;
-		e1 = (int)(dx1 >> 1);
-
-		for (int i = 0; i < dx1;) {
-			t1xp = 0; t2xp = 0;
-			if (t1x < t2x) { minx = t1x; maxx = t2x; }
-			else { minx = t2x; maxx = t1x; }
-			// process first line until y value is about to change
-			while (i < dx1) {
-				i++;
-				e1 += dy1;
-				while (e1 >= dx1) {
-					e1 -= dx1;
-					if (changed1) t1xp = signx1;//t1x += signx1;
-					else          goto next1;
-				}
-				if (changed1) break;
-				else t1x += signx1;
-			}
-			// Move line
-		next1:
-			// process second line until y value is about to change
-			while (1) {
-				e2 += dy2;
-				while (e2 >= dx2) {
-					e2 -= dx2;
-					if (changed2) t2xp = signx2;//t2x += signx2;
-					else          goto next2;
-				}
-				if (changed2)     break;
-				else              t2x += signx2;
-			}
-		next2:
-			if (minx > t1x) minx = t1x;
-			if (minx > t2x) minx = t2x;
-			if (maxx < t1x) maxx = t1x;
-			if (maxx < t2x) maxx = t2x;
-			drawline(minx, maxx, y);    // Draw line from min to max points found on the y
-			// Now increase y
-			if (!changed1) t1x += signx1;
-			t1x += t1xp;
-			if (!changed2) t2x += signx2;
-			t2x += t2xp;
-			y += 1;
-			if (y == y2) break;
-		}
-	next:
-		// Second half
-		dx1 = (int)(x3 - x2); if (dx1 < 0) { dx1 = -dx1; signx1 = -1; }
-		else signx1 = 1;
-		dy1 = (int)(y3 - y2);
-		t1x = x2;
-
-		if (dy1 > dx1) {   // swap values
-			std::swap(dy1, dx1);
-			changed1 = true;
-		}
-		else changed1 = false;
-
-		e1 = (int)(dx1 >> 1);
-
-		for (int i = 0; i <= dx1; i++) {
-			t1xp = 0; t2xp = 0;
-			if (t1x < t2x) { minx = t1x; maxx = t2x; }
-			else { minx = t2x; maxx = t1x; }
-			// process first line until y value is about to change
-			while (i < dx1) {
-				e1 += dy1;
-				while (e1 >= dx1) {
-					e1 -= dx1;
-					if (changed1) { t1xp = signx1; break; }//t1x += signx1;
-					else          goto next3;
-				}
-				if (changed1) break;
-				else   	   	  t1x += signx1;
-				if (i < dx1) i++;
-			}
-		next3:
-			// process second line until y value is about to change
-			while (t2x != x3) {
-				e2 += dy2;
-				while (e2 >= dx2) {
-					e2 -= dx2;
-					if (changed2) t2xp = signx2;
-					else          goto next4;
-				}
-				if (changed2)     break;
-				else              t2x += signx2;
-			}
-		next4:
-
-			if (minx > t1x) minx = t1x;
-			if (minx > t2x) minx = t2x;
-			if (maxx < t1x) maxx = t1x;
-			if (maxx < t2x) maxx = t2x;
-			drawline(minx, maxx, y);
-			if (!changed1) t1x += signx1;
-			t1x += t1xp;
-			if (!changed2) t2x += signx2;
-			t2x += t2xp;
-			y += 1;
-			if (y > y3) return;
-		}
-	}
-
-	void PixelGameEngine::FillTexturedTriangle(std::vector<olc::vf2d> vPoints, std::vector<olc::vf2d> vTex, std::vector<olc::Pixel> vColour, olc::Sprite* sprTex)
+	void PixelGameEngine::DrawTriangle(int32_t x1, int32_t y1, int32_t x2, int32_t y2, int32_t x3, int32_t y3, Pixel p)
 	{
-		olc::vi2d p1 = vPoints[0];
-		olc::vi2d p2 = vPoints[1];
-		olc::vi2d p3 = vPoints[2];
+		DrawLine(x1, y1, x2, y2, p);
+		DrawLine(x2, y2, x3, y3, p);
+		DrawLine(x3, y3, x1, y1, p);
+	}
 
-		if (p2.y < p1.y) { std::swap(p1.y, p2.y); std::swap(p1.x, p2.x); std::swap(vTex[0].x, vTex[1].x); std::swap(vTex[0].y, vTex[1].y); std::swap(vColour[0], vColour[1]); }
-		if (p3.y < p1.y) { std::swap(p1.y, p3.y); std::swap(p1.x, p3.x); std::swap(vTex[0].x, vTex[2].x); std::swap(vTex[0].y, vTex[2].y); std::swap(vColour[0], vColour[2]); }
-		if (p3.y < p2.y) { std::swap(p2.y, p3.y); std::swap(p2.x, p3.x); std::swap(vTex[1].x, vTex[2].x); std::swap(vTex[1].y, vTex[2].y); std::swap(vColour[1], vColour[2]); }
+	void PixelGameEngine::FillTriangle(const olc::vi2d& pos1, const olc::vi2d& pos2, const olc::vi2d& pos3, Pixel p)
+	{
+		FillTriangle(pos1.x, pos1.y, pos2.x, pos2.y, pos3.x, pos3.y, p);
+	}
 
-		olc::vi2d dPos1 = p2 - p1;
-		olc::vf2d dTex1 = vTex[1] - vTex[0];
-		int dcr1 = vColour[1].r - vColour[0].r;
-		int dcg1 = vColour[1].g - vColour[0].g;
-		int dcb1 = vColour[1].b - vColour[0].b;
-		int dca1 = vColour[1].a - vColour[0].a;
+	template<typename F>
+	void PixelGameEngine::RasterTriangle(const olc::vf2d& p0, const olc::vf2d& p1, const olc::vf2d& p2, F&& emit)
+	{
+		if (!pDrawTarget) return;
 
-		olc::vi2d dPos2 = p3 - p1;
-		olc::vf2d dTex2 = vTex[2] - vTex[0];
-		int dcr2 = vColour[2].r - vColour[0].r;
-		int dcg2 = vColour[2].g - vColour[0].g;
-		int dcb2 = vColour[2].b - vColour[0].b;
-		int dca2 = vColour[2].a - vColour[0].a;
+		// Snap to 28.4 fixed point, pixel centres sit on integer coordinates
+		auto fixed = [](float f) { return int64_t(std::floor(std::max(-1.0e7f, std::min(1.0e7f, f)) * 16.0f + 0.5f)); };
+		int64_t X0 = fixed(p0.x), Y0 = fixed(p0.y);
+		int64_t X1 = fixed(p1.x), Y1 = fixed(p1.y);
+		int64_t X2 = fixed(p2.x), Y2 = fixed(p2.y);
 
-		float dax_step = 0, dbx_step = 0, dcr1_step = 0, dcr2_step = 0, dcg1_step = 0, dcg2_step = 0, dcb1_step = 0, dcb2_step = 0, dca1_step = 0, dca2_step = 0;
-		olc::vf2d vTex1Step, vTex2Step;
+		const int64_t nArea = (X1 - X0) * (Y2 - Y0) - (Y1 - Y0) * (X2 - X0);
+		if (nArea == 0) return;
+		if (nArea < 0) { std::swap(X1, X2); std::swap(Y1, Y2); }
 
-		if (dPos1.y)
-		{
-			dax_step = dPos1.x / (float)abs(dPos1.y);
-			vTex1Step = dTex1 / (float)abs(dPos1.y);
-			dcr1_step = dcr1 / (float)abs(dPos1.y);
-			dcg1_step = dcg1 / (float)abs(dPos1.y);
-			dcb1_step = dcb1 / (float)abs(dPos1.y);
-			dca1_step = dca1 / (float)abs(dPos1.y);
-		}
+		// Bounding box of covered pixel centres, clipped to the target
+		auto floordiv = [](int64_t n, int64_t d) { return n >= 0 ? n / d : -((-n + d - 1) / d); };
+		auto floor16 = [&](int64_t v) { return floordiv(v, 16); };
+		const int32_t nMinX = int32_t(std::max<int64_t>(0, -floor16(-std::min({ X0, X1, X2 }))));
+		const int32_t nMinY = int32_t(std::max<int64_t>(0, -floor16(-std::min({ Y0, Y1, Y2 }))));
+		const int32_t nMaxX = int32_t(std::min<int64_t>(pDrawTarget->width - 1, floor16(std::max({ X0, X1, X2 }))));
+		const int32_t nMaxY = int32_t(std::min<int64_t>(pDrawTarget->height - 1, floor16(std::max({ Y0, Y1, Y2 }))));
+		if (nMinX > nMaxX || nMinY > nMaxY) return;
 
-		if (dPos2.y)
+		// E(x, y) = a*x + b*y + c, positive inside. Pixels exactly on an edge
+		// belong to it only if it is a top or left edge, so shared edges of
+		// adjacent triangles are drawn exactly once
+		struct Edge
 		{
-			dbx_step = dPos2.x / (float)abs(dPos2.y);
-			vTex2Step = dTex2 / (float)abs(dPos2.y);
-			dcr2_step = dcr2 / (float)abs(dPos2.y);
-			dcg2_step = dcg2 / (float)abs(dPos2.y);
-			dcb2_step = dcb2 / (float)abs(dPos2.y);
-			dca2_step = dca2 / (float)abs(dPos2.y);
-		}
-
-		olc::vi2d vStart;
-		olc::vi2d vEnd;
-		int vStartIdx;
-
-		for (int pass = 0; pass < 2; pass++)
+			int64_t a, b, c;
+			int64_t operator()(int64_t x, int64_t y) const { return a * x + b * y + c; }
+		};
+		auto edge = [](int64_t xa, int64_t ya, int64_t xb, int64_t yb)
 		{
-			if (pass == 0)
+			Edge e{ -(yb - ya) * 16, (xb - xa) * 16, (yb - ya) * xa - (xb - xa) * ya };
+			const bool bTopLeft = (ya == yb && xb > xa) || (yb < ya);
+			if (!bTopLeft) e.c -= 1;
+			return e;
+		};
+		const Edge e[3] = { edge(X1, Y1, X2, Y2), edge(X2, Y2, X0, Y0), edge(X0, Y0, X1, Y1) };
+
+		// Convex, so coverage of each row is a single span
+		int32_t nRowMin[8], nRowMax[8];
+		for (int32_t by = nMinY & ~7; by <= nMaxY; by += 8)
+		{
+			const int32_t y0 = std::max(by, nMinY), y1 = std::min(by + 7, nMaxY);
+			std::fill_n(nRowMin, 8, INT32_MAX);
+			std::fill_n(nRowMax, 8, INT32_MIN);
+
+			// Narrow the walk to the part of this strip each edge permits, and
+			// find the inner part that every row of the strip covers fully.
+			// Costs a few divides, so not worth it for narrow triangles
+			int64_t nStripMin = nMinX, nStripMax = nMaxX;
+			int64_t nInnerMin = nMinX, nInnerMax = nMinX - 1;
+			if (nMaxX - nMinX >= 32)
 			{
-				vStart = p1; vEnd = p2;	vStartIdx = 0;
+				nInnerMax = nMaxX;
+				for (const auto& ed : e)
+				{
+					const int64_t v0 = ed.b * y0 + ed.c, v1 = ed.b * y1 + ed.c;
+					const int64_t vHi = std::max(v0, v1), vLo = std::min(v0, v1);
+					if (ed.a > 0)
+					{
+						nStripMin = std::max(nStripMin, -floordiv(vHi, ed.a));
+						nInnerMin = std::max(nInnerMin, -floordiv(vLo, ed.a));
+					}
+					else if (ed.a < 0)
+					{
+						nStripMax = std::min(nStripMax, floordiv(vHi, -ed.a));
+						nInnerMax = std::min(nInnerMax, floordiv(vLo, -ed.a));
+					}
+					else if (vLo < 0)
+						nInnerMax = nInnerMin - 1;
+				}
 			}
-			else
-			{
-				dPos1 = p3 - p2;
-				dTex1 = vTex[2] - vTex[1];
-				dcr1 = vColour[2].r - vColour[1].r;
-				dcg1 = vColour[2].g - vColour[1].g;
-				dcb1 = vColour[2].b - vColour[1].b;
-				dca1 = vColour[2].a - vColour[1].a;
-				dcr1_step = 0; dcg1_step = 0; dcb1_step = 0; dca1_step = 0;
 
-				if (dPos2.y) dbx_step = dPos2.x / (float)abs(dPos2.y);
-				if (dPos1.y)
+			if (nInnerMin <= nInnerMax)
+				for (int32_t y = y0; y <= y1; y++)
 				{
-					dax_step = dPos1.x / (float)abs(dPos1.y);
-					vTex1Step = dTex1 / (float)abs(dPos1.y);
-					dcr1_step = dcr1 / (float)abs(dPos1.y);
-					dcg1_step = dcg1 / (float)abs(dPos1.y);
-					dcb1_step = dcb1 / (float)abs(dPos1.y);
-					dca1_step = dca1 / (float)abs(dPos1.y);
+					nRowMin[y - by] = int32_t(nInnerMin);
+					nRowMax[y - by] = int32_t(nInnerMax);
 				}
 
-				vStart = p2; vEnd = p3; vStartIdx = 1;
-			}
-
-			if (dPos1.y)
+			bool bCovered = false;
+			for (int32_t bx = int32_t(nStripMin) & ~7; bx <= nStripMax; bx += 8)
 			{
-				for (int i = vStart.y; i <= vEnd.y; i++)
+				const int32_t x0 = std::max(bx, nMinX), x1 = std::min(bx + 7, nMaxX);
+
+				// Blocks inside the inner part need no testing, hop over them
+				if (x0 >= nInnerMin && x1 <= nInnerMax)
 				{
-					int ax = int(vStart.x + (float)(i - vStart.y) * dax_step);
-					int bx = int(p1.x + (float)(i - p1.y) * dbx_step);
+					bCovered = true;
+					bx = (int32_t(nInnerMax + 1) & ~7) - 8;
+					continue;
+				}
 
-					olc::vf2d tex_s(vTex[vStartIdx].x + (float)(i - vStart.y) * vTex1Step.x, vTex[vStartIdx].y + (float)(i - vStart.y) * vTex1Step.y);
-					olc::vf2d tex_e(vTex[0].x + (float)(i - p1.y) * vTex2Step.x, vTex[0].y + (float)(i - p1.y) * vTex2Step.y);
+				// Edges are linear, so testing block corners is enough to
+				// accept or reject the whole block
+				bool bReject = false, bAccept = true;
+				for (const auto& ed : e)
+				{
+					const int64_t c = ed(x0, y0);
+					const int64_t dx = ed.a * (x1 - x0), dy = ed.b * (y1 - y0);
+					if (c + std::max<int64_t>(dx, 0) + std::max<int64_t>(dy, 0) < 0) { bReject = true; break; }
+					if (c + std::min<int64_t>(dx, 0) + std::min<int64_t>(dy, 0) < 0) bAccept = false;
+				}
 
-					olc::Pixel col_s(vColour[vStartIdx].r + uint8_t((float)(i - vStart.y) * dcr1_step), vColour[vStartIdx].g + uint8_t((float)(i - vStart.y) * dcg1_step),
-						vColour[vStartIdx].b + uint8_t((float)(i - vStart.y) * dcb1_step), vColour[vStartIdx].a + uint8_t((float)(i - vStart.y) * dca1_step));
+				// A strip through a convex shape is convex too, so once coverage
+				// has started, the first empty block ends this row of blocks
+				if (bReject) { if (bCovered) break; continue; }
+				bCovered = true;
 
-					olc::Pixel col_e(vColour[0].r + uint8_t((float)(i - p1.y) * dcr2_step), vColour[0].g + uint8_t((float)(i - p1.y) * dcg2_step),
-						vColour[0].b + uint8_t((float)(i - p1.y) * dcb2_step), vColour[0].a + uint8_t((float)(i - p1.y) * dca2_step));
+				for (int32_t y = y0; y <= y1; y++)
+				{
+					int32_t& rmin = nRowMin[y - by];
+					int32_t& rmax = nRowMax[y - by];
+					if (bAccept)
+					{
+						rmin = std::min(rmin, x0); rmax = std::max(rmax, x1);
+						continue;
+					}
 
-					if (ax > bx) { std::swap(ax, bx); std::swap(tex_s, tex_e); std::swap(col_s, col_e); }
+					// Each edge either passes the whole row, fails it, or cuts
+					// it once, so walk only the edges that cut to find the span
+					int32_t nLo = x0, nHi = x1;
+					for (const auto& ed : e)
+					{
+						int64_t w = ed(x0, y);
+						const int64_t wEnd = w + ed.a * (x1 - x0);
+						if (w >= 0 && wEnd >= 0) continue;
+						if (w < 0 && wEnd < 0) { nHi = nLo - 1; break; }
 
-					float tstep = 1.0f / ((float)(bx - ax));
-					float t = 0.0f;
+						int32_t x = x0;
+						if (w < 0)
+						{
+							while (w < 0) { w += ed.a; x++; }
+							nLo = std::max(nLo, x);
+						}
+						else
+						{
+							while (w + ed.a >= 0) { w += ed.a; x++; }
+							nHi = std::min(nHi, x);
+						}
+					}
 
-					for (int j = ax; j < bx; j++)
+					if (nLo <= nHi)
 					{
-						olc::Pixel pixel = PixelLerp(col_s, col_e, t);
-						if (sprTex != nullptr) pixel *= sprTex->Sample(tex_s.lerp(tex_e, t));
-						Draw(j, i, pixel);
-						t += tstep;
+						rmin = std::min(rmin, nLo); rmax = std::max(rmax, nHi);
 					}
 				}
 			}
+
+			for (int32_t y = y0; y <= y1; y++)
+				if (nRowMin[y - by] <= nRowMax[y - by])
+					emit(y, nRowMin[y - by], nRowMax[y - by]);
+		}
+	}
+
+	void PixelGameEngine::FillTriangle(int32_t x1, int32_t y1, int32_t x2, int32_t y2, int32_t x3, int32_t y3, Pixel p)
+	{
+		// Unlike 2.29, pixels on the right and bottom edges are left to the
+		// neighbouring triangle, and triangles with no area draw nothing. In
+		// return, triangles sharing an edge neither overlap nor leave gaps
+		RasterTriangle(olc::vf2d(float(x1), float(y1)), olc::vf2d(float(x2), float(y2)), olc::vf2d(float(x3), float(y3)),
+			[&](int32_t y, int32_t sx, int32_t ex) { SpanFill(sx, ex, y, p); });
+	}
+
+	void PixelGameEngine::FillTexturedTriangle(const std::vector<olc::vf2d>& vPoints, const std::vector<olc::vf2d>& vTex, const std::vector<olc::Pixel>& vColour, olc::Sprite* sprTex)
+	{
+		if (vPoints.size() < 3 || vTex.size() < 3 || vColour.size() < 3)
+			return;
+		FillTexturedTriangle(vPoints.data(), vTex.data(), vColour.data(), sprTex);
+	}
+
+	void PixelGameEngine::FillTexturedTriangle(const olc::vf2d* pPoints, const olc::vf2d* pTex, const olc::Pixel* pColour, olc::Sprite* sprTex)
+	{
+		// Attributes (u, v, r, g, b, a) are planar across the triangle, so each is
+		// a0 + dx * (x - x0) + dy * (y - y0)
+		const olc::vf2d d1 = pPoints[1] - pPoints[0], d2 = pPoints[2] - pPoints[0];
+		const float fDet = d1.x * d2.y - d2.x * d1.y;
+		if (fDet == 0.0f) return;
+		const float fInvDet = 1.0f / fDet;
+
+		constexpr int N = 6;
+		float fBase[N], fDX[N], fDY[N];
+		for (int k = 0; k < N; k++)
+		{
+			float a[3];
+			for (int v = 0; v < 3; v++)
+			{
+				const float fAttr[N] = { pTex[v].x, pTex[v].y, float(pColour[v].r), float(pColour[v].g), float(pColour[v].b), float(pColour[v].a) };
+				a[v] = fAttr[k];
+			}
+			fBase[k] = a[0];
+			fDX[k] = ((a[1] - a[0]) * d2.y - (a[2] - a[0]) * d1.y) * fInvDet;
+			fDY[k] = ((a[2] - a[0]) * d1.x - (a[1] - a[0]) * d2.x) * fInvDet;
 		}
+
+		RasterTriangle(pPoints[0], pPoints[1], pPoints[2], [&](int32_t y, int32_t sx, int32_t ex)
+			{
+				const int32_t nLen = ex - sx + 1;
+				if (vSpanScratch.size() < size_t(nLen)) vSpanScratch.resize(nLen);
+
+				float f[N];
+				for (int k = 0; k < N; k++)
+					f[k] = fBase[k] + fDX[k] * (float(sx) - pPoints[0].x) + fDY[k] * (float(y) - pPoints[0].y);
+
+				auto channel = [](float c) { return uint8_t(std::min(255.0f, std::max(0.0f, c))); };
+				for (int32_t i = 0; i < nLen; i++)
+				{
+					olc::Pixel pixel(channel(f[2]), channel(f[3]), channel(f[4]), channel(f[5]));
+					if (sprTex != nullptr) pixel *= sprTex->Sample(f[0], f[1]);
+					vSpanScratch[i] = pixel;
+					for (int k = 0; k < N; k++) f[k] += fDX[k];
+				}
+
+				SpanCopy(sx, y, vSpanScratch.data(), nLen);
+			});
 	}
 
 	void PixelGameEngine::FillTexturedPolygon(const std::vector<olc::vf2d>& vPoints, const std::vector<olc::vf2d>& vTex, const std::vector<olc::Pixel>& vColour, olc::Sprite* sprTex, olc::DecalStructure structure)
+	{
+		if (vPoints.size() < 3 || vTex.size() < 3 || vColour.size() < 3)
+			return;
+
+		const size_t nElements = std::min({ vPoints.size(), vTex.size(), vColour.size() });
+		FillTexturedPolygon(vPoints.data(), vTex.data(), vColour.data(), uint32_t(nElements), sprTex, structure);
+	}
+
+	void PixelGameEngine::FillTexturedPolygon(const olc::vf2d* pPoints, const olc::vf2d* pTex, const olc::Pixel* pColour, uint32_t elements, olc::Sprite* sprTex, olc::DecalStructure structure)
 	{
 		if (structure == olc::DecalStructure::LINE)
 		{
 			return; // Meaningless, so do nothing
 		}
 
-		if (vPoints.size() < 3 || vTex.size() < 3 || vColour.size() < 3)
+		if (elements < 3)
 			return;
 
+		// Gather each triangle's vertices into small local arrays
+		olc::vf2d vP[3], vT[3];
+		olc::Pixel vC[3];
+		auto tri = [&](uint32_t i0, uint32_t i1, uint32_t i2)
+		{
+			vP[0] = pPoints[i0]; vP[1] = pPoints[i1]; vP[2] = pPoints[i2];
+			vT[0] = pTex[i0]; vT[1] = pTex[i1]; vT[2] = pTex[i2];
+			vC[0] = pColour[i0]; vC[1] = pColour[i1]; vC[2] = pColour[i2];
+			FillTexturedTriangle(vP, vT, vC, sprTex);
+		};
+
 		if (structure == olc::DecalStructure::LIST)
 		{
-			for (size_t tri = 0; tri < vPoints.size() / 3; tri++)
-			{
-				std::vector<olc::vf2d> vP = { vPoints[tri * 3 + 0], vPoints[tri * 3 + 1], vPoints[tri * 3 + 2] };
-				std::vector<olc::vf2d> vT = { vTex[tri * 3 + 0], vTex[tri * 3 + 1], vTex[tri * 3 + 2] };
-				std::vector<olc::Pixel> vC = { vColour[tri * 3 + 0], vColour[tri * 3 + 1], vColour[tri * 3 + 2] };
-				FillTexturedTriangle(vP, vT, vC, sprTex);
-			}
+			for (uint32_t t = 0; t < elements / 3; t++)
+				tri(t * 3 + 0, t * 3 + 1, t * 3 + 2);
 			return;
 		}
 
 		if (structure == olc::DecalStructure::STRIP)
 		{
-			for (size_t tri = 2; tri < vPoints.size(); tri++)
-			{
-				std::vector<olc::vf2d> vP = { vPoints[tri - 2], vPoints[tri - 1], vPoints[tri] };
-				std::vector<olc::vf2d> vT = { vTex[tri - 2], vTex[tri - 1], vTex[tri] };
-				std::vector<olc::Pixel> vC = { vColour[tri - 2], vColour[tri - 1], vColour[tri] };
-				FillTexturedTriangle(vP, vT, vC, sprTex);
-			}
+			for (uint32_t t = 2; t < elements; t++)
+				tri(t - 2, t - 1, t);
 			return;
 		}
 
 		if (structure == olc::DecalStructure::FAN)
 		{
-			for (size_t tri = 2; tri < vPoints.size(); tri++)
-			{
-				std::vector<olc::vf2d> vP = { vPoints[0], vPoints[tri - 1], vPoints[tri] };
-				std::vector<olc::vf2d> vT = { vTex[0], vTex[tri - 1], vTex[tri] };
-				std::vector<olc::Pixel> vC = { vColour[0], vColour[tri - 1], vColour[tri] };
-				FillTexturedTriangle(vP, vT, vC, sprTex);
-			}
+			for (uint32_t t = 2; t < elements; t++)
+				tri(0, t - 1, t);
 			return;
 		}
 	}
@@ -3234,33 +5875,7 @@ namespace olc
 		if (sprite == nullptr)
 			return;
 
-		int32_t fxs = 0, fxm = 1, fx = 0;
-		int32_t fys = 0, fym = 1, fy = 0;
-		if (flip & olc::Sprite::Flip::HORIZ) { fxs = sprite->width - 1; fxm = -1; }
-		if (flip & olc::Sprite::Flip::VERT) { fys = sprite->height - 1; fym = -1; }
-
-		if (scale > 1)
-		{
-			fx = fxs;
-			for (int32_t i = 0; i < sprite->width; i++, fx += fxm)
-			{
-				fy = fys;
-				for (int32_t j = 0; j < sprite->height; j++, fy += fym)
-					for (uint32_t is = 0; is < scale; is++)
-						for (uint32_t js = 0; js < scale; js++)
-							Draw(x + (i * scale) + is, y + (j * scale) + js, sprite->GetPixel(fx, fy));
-			}
-		}
-		else
-		{
-			fx = fxs;
-			for (int32_t i = 0; i < sprite->width; i++, fx += fxm)
-			{
-				fy = fys;
-				for (int32_t j = 0; j < sprite->height; j++, fy += fym)
-					Draw(x + i, y + j, sprite->GetPixel(fx, fy));
-			}
-		}
+		DrawPartialSprite(x, y, sprite, 0, 0, sprite->width, sprite->height, scale, flip);
 	}
 
 	void PixelGameEngine::DrawPartialSprite(const olc::vi2d& pos, Sprite* sprite, const olc::vi2d& sourcepos, const olc::vi2d& size, uint32_t scale, uint8_t flip)
@@ -3270,35 +5885,65 @@ namespace olc
 
 	void PixelGameEngine::DrawPartialSprite(int32_t x, int32_t y, Sprite* sprite, int32_t ox, int32_t oy, int32_t w, int32_t h, uint32_t scale, uint8_t flip)
 	{
-		if (sprite == nullptr)
+		if (sprite == nullptr || pDrawTarget == nullptr || w <= 0 || h <= 0)
+			return;
+
+		if (scale < 1) scale = 1;
+		const int32_t s = int32_t(scale);
+		const bool bFlipX = (flip & olc::Sprite::Flip::HORIZ) != 0;
+		const bool bFlipY = (flip & olc::Sprite::Flip::VERT) != 0;
+
+		// Clip destination rectangle to draw target, once
+		const int32_t dx0 = std::max(x, 0), dx1 = std::min(x + w * s, pDrawTarget->width);
+		const int32_t dy0 = std::max(y, 0), dy1 = std::min(y + h * s, pDrawTarget->height);
+		if (dx0 >= dx1 || dy0 >= dy1)
 			return;
 
-		int32_t fxs = 0, fxm = 1, fx = 0;
-		int32_t fys = 0, fym = 1, fy = 0;
-		if (flip & olc::Sprite::Flip::HORIZ) { fxs = w - 1; fxm = -1; }
-		if (flip & olc::Sprite::Flip::VERT) { fys = h - 1; fym = -1; }
+		// Source columns [i0, i1) of the (unflipped) region that land in view
+		const int32_t i0 = (dx0 - x) / s, i1 = (dx1 - x + s - 1) / s;
 
-		if (scale > 1)
+		// Sampling outside the source, or reading from the draw target itself, must
+		// go through GetPixel() to respect sample modes and avoid aliasing
+		const bool bDirect = sprite != pDrawTarget && ox >= 0 && oy >= 0 && ox + w <= sprite->width && oy + h <= sprite->height;
+
+		// Unscaled, unflipped rows can be handed straight to the span writer
+		if (bDirect && s == 1 && !bFlipX)
 		{
-			fx = fxs;
-			for (int32_t i = 0; i < w; i++, fx += fxm)
+			for (int32_t dy = dy0; dy < dy1; dy++)
 			{
-				fy = fys;
-				for (int32_t j = 0; j < h; j++, fy += fym)
-					for (uint32_t is = 0; is < scale; is++)
-						for (uint32_t js = 0; js < scale; js++)
-							Draw(x + (i * scale) + is, y + (j * scale) + js, sprite->GetPixel(fx + ox, fy + oy));
+				const int32_t sy = oy + (bFlipY ? (h - 1 - (dy - y)) : (dy - y));
+				SpanCopy(dx0, dy, sprite->pColData.data() + size_t(sy) * sprite->width + ox + i0, dx1 - dx0);
 			}
+			return;
 		}
-		else
+
+		// Otherwise expand each visible source row (flipped and scaled) into a
+		// scratch row once, and emit it for each destination row it covers
+		vSpanScratch.resize(size_t(i1 - i0) * s);
+		int32_t jLast = -1;
+		for (int32_t dy = dy0; dy < dy1; dy++)
 		{
-			fx = fxs;
-			for (int32_t i = 0; i < w; i++, fx += fxm)
+			const int32_t j = (dy - y) / s;
+			if (j != jLast)
 			{
-				fy = fys;
-				for (int32_t j = 0; j < h; j++, fy += fym)
-					Draw(x + i, y + j, sprite->GetPixel(fx + ox, fy + oy));
+				const int32_t sy = oy + (bFlipY ? (h - 1 - j) : j);
+				Pixel* pOut = vSpanScratch.data();
+				if (bDirect)
+				{
+					const Pixel* pRow = sprite->pColData.data() + size_t(sy) * sprite->width + ox;
+					if (bFlipX)
+						for (int32_t i = i0; i < i1; i++, pOut += s) std::fill_n(pOut, s, pRow[w - 1 - i]);
+					else
+						for (int32_t i = i0; i < i1; i++, pOut += s) std::fill_n(pOut, s, pRow[i]);
+				}
+				else
+				{
+					for (int32_t i = i0; i < i1; i++, pOut += s)
+						std::fill_n(pOut, s, sprite->GetPixel(ox + (bFlipX ? (w - 1 - i) : i), sy));
+				}
+				jLast = j;
 			}
+			SpanCopy(x + i0 * s, dy, vSpanScratch.data(), (i1 - i0) * s);
 		}
 	}
 
@@ -3312,6 +5957,11 @@ namespace olc
 		nDecalStructure = structure;
 	}
 
+	olc::DecalMode PixelGameEngine::GetDecalMode() const
+	{
+		return nDecalMode;
+	}
+
 	void PixelGameEngine::DrawPartialDecal(const olc::vf2d& pos, olc::Decal* decal, const olc::vf2d& source_pos, const olc::vf2d& source_size, const olc::vf2d& scale, const olc::Pixel& tint)
 	{
 		olc::vf2d vScreenSpacePos =
@@ -3331,18 +5981,12 @@ namespace olc
 		olc::vf2d vQuantisedPos = ((vScreenSpacePos * vWindow) + olc::vf2d(0.5f, 0.5f)).floor() / vWindow;
 		olc::vf2d vQuantisedDim = ((vScreenSpaceDim * vWindow) + olc::vf2d(0.5f, -0.5f)).ceil() / vWindow;
 
-		DecalInstance di;
-		di.points = 4;
-		di.decal = decal;
-		di.tint = { tint, tint, tint, tint };
-		di.pos = { { vQuantisedPos.x, vQuantisedPos.y }, { vQuantisedPos.x, vQuantisedDim.y }, { vQuantisedDim.x, vQuantisedDim.y }, { vQuantisedDim.x, vQuantisedPos.y } };
-		olc::vf2d uvtl = (source_pos + olc::vf2d(0.0001f, 0.0001f)) * decal->vUVScale;
-		olc::vf2d uvbr = (source_pos + source_size - olc::vf2d(0.0001f, 0.0001f)) * decal->vUVScale;
-		di.uv = { { uvtl.x, uvtl.y }, { uvtl.x, uvbr.y }, { uvbr.x, uvbr.y }, { uvbr.x, uvtl.y } };
-		di.w = { 1,1,1,1 };
-		di.mode = nDecalMode;
-		di.structure = nDecalStructure;
-		vLayers[nTargetLayer].vecDecalInstance.push_back(di);
+		DecalInstance& di = NewDecalInstance(decal, 4);
+		std::fill_n(di.tint, 4, tint);
+		DecalQuadCorners(di.pos, vQuantisedPos, vQuantisedDim);
+		olc::vf2d uvtl = decal->vUVOffset + (source_pos + olc::vf2d(0.0001f, 0.0001f)) * decal->vUVScale;
+		olc::vf2d uvbr = decal->vUVOffset + (source_pos + source_size - olc::vf2d(0.0001f, 0.0001f)) * decal->vUVScale;
+		DecalQuadCorners(di.uv, uvtl, uvbr);
 	}
 
 	void PixelGameEngine::DrawPartialDecal(const olc::vf2d& pos, const olc::vf2d& size, olc::Decal* decal, const olc::vf2d& source_pos, const olc::vf2d& source_size, const olc::Pixel& tint)
@@ -3359,18 +6003,12 @@ namespace olc
 			vScreenSpacePos.y - (2.0f * size.y * vInvScreenSize.y)
 		};
 
-		DecalInstance di;
-		di.points = 4;
-		di.decal = decal;
-		di.tint = { tint, tint, tint, tint };
-		di.pos = { { vScreenSpacePos.x, vScreenSpacePos.y }, { vScreenSpacePos.x, vScreenSpaceDim.y }, { vScreenSpaceDim.x, vScreenSpaceDim.y }, { vScreenSpaceDim.x, vScreenSpacePos.y } };
-		olc::vf2d uvtl = (source_pos)*decal->vUVScale;
+		DecalInstance& di = NewDecalInstance(decal, 4);
+		std::fill_n(di.tint, 4, tint);
+		DecalQuadCorners(di.pos, vScreenSpacePos, vScreenSpaceDim);
+		olc::vf2d uvtl = decal->vUVOffset + (source_pos)*decal->vUVScale;
 		olc::vf2d uvbr = uvtl + ((source_size)*decal->vUVScale);
-		di.uv = { { uvtl.x, uvtl.y }, { uvtl.x, uvbr.y }, { uvbr.x, uvbr.y }, { uvbr.x, uvtl.y } };
-		di.w = { 1,1,1,1 };
-		di.mode = nDecalMode;
-		di.structure = nDecalStructure;
-		vLayers[nTargetLayer].vecDecalInstance.push_back(di);
+		DecalQuadCorners(di.uv, uvtl, uvbr);
 	}
 
 
@@ -3388,130 +6026,125 @@ namespace olc
 			vScreenSpacePos.y - (2.0f * (float(decal->sprite->height) * vInvScreenSize.y)) * scale.y
 		};
 
-		DecalInstance di;
-		di.decal = decal;
-		di.points = 4;
-		di.tint = { tint, tint, tint, tint };
-		di.pos = { { vScreenSpacePos.x, vScreenSpacePos.y }, { vScreenSpacePos.x, vScreenSpaceDim.y }, { vScreenSpaceDim.x, vScreenSpaceDim.y }, { vScreenSpaceDim.x, vScreenSpacePos.y } };
-		di.uv = { { 0.0f, 0.0f}, {0.0f, 1.0f}, {1.0f, 1.0f}, {1.0f, 0.0f} };
-		di.w = { 1, 1, 1, 1 };
-		di.mode = nDecalMode;
-		di.structure = nDecalStructure;
-		vLayers[nTargetLayer].vecDecalInstance.push_back(di);
+		DecalInstance& di = NewDecalInstance(decal, 4);
+		std::fill_n(di.tint, 4, tint);
+		DecalQuadCorners(di.pos, vScreenSpacePos, vScreenSpaceDim);
+		DecalQuadCorners(di.uv, decal->vUVOffset, decal->vUVOffset + decal->vUVExtent);
 	}
 
 	void PixelGameEngine::DrawExplicitDecal(olc::Decal* decal, const olc::vf2d* pos, const olc::vf2d* uv, const olc::Pixel* col, uint32_t elements)
 	{
-		DecalInstance di;
-		di.decal = decal;
-		di.pos.resize(elements);
-		di.uv.resize(elements);
-		di.w.resize(elements);
-		di.tint.resize(elements);
-		di.points = elements;
+		DecalInstance& di = NewDecalInstance(decal, elements);
+		const olc::vf2d vUVOffset = decal ? decal->vUVOffset : olc::vf2d(0.0f, 0.0f);
+		const olc::vf2d vUVExtent = decal ? decal->vUVExtent : olc::vf2d(1.0f, 1.0f);
 		for (uint32_t i = 0; i < elements; i++)
 		{
 			di.pos[i] = { (pos[i].x * vInvScreenSize.x) * 2.0f - 1.0f, ((pos[i].y * vInvScreenSize.y) * 2.0f - 1.0f) * -1.0f };
-			di.uv[i] = uv[i];
+			di.uv[i] = vUVOffset + uv[i] * vUVExtent;
 			di.tint[i] = col[i];
 			di.w[i] = 1.0f;
 		}
-		di.mode = nDecalMode;
-		di.structure = nDecalStructure;
-		vLayers[nTargetLayer].vecDecalInstance.push_back(di);
 	}
 
 	void PixelGameEngine::DrawPolygonDecal(olc::Decal* decal, const std::vector<olc::vf2d>& pos, const std::vector<olc::vf2d>& uv, const olc::Pixel tint)
 	{
-		DecalInstance di;
-		di.decal = decal;
-		di.points = uint32_t(pos.size());
-		di.pos.resize(di.points);
-		di.uv.resize(di.points);
-		di.w.resize(di.points);
-		di.tint.resize(di.points);
-		for (uint32_t i = 0; i < di.points; i++)
-		{
-			di.pos[i] = { (pos[i].x * vInvScreenSize.x) * 2.0f - 1.0f, ((pos[i].y * vInvScreenSize.y) * 2.0f - 1.0f) * -1.0f };
-			di.uv[i] = uv[i];
-			di.tint[i] = tint;
-			di.w[i] = 1.0f;
-		}
-		di.mode = nDecalMode;
-		di.structure = nDecalStructure;
-		vLayers[nTargetLayer].vecDecalInstance.push_back(di);
+		DrawPolygonDecal(decal, pos.data(), nullptr, uv.data(), nullptr, uint32_t(pos.size()), tint);
 	}
 
 	void PixelGameEngine::DrawPolygonDecal(olc::Decal* decal, const std::vector<olc::vf2d>& pos, const std::vector<olc::vf2d>& uv, const std::vector<olc::Pixel>& tint)
 	{
-		DecalInstance di;
-		di.decal = decal;
-		di.points = uint32_t(pos.size());
-		di.pos.resize(di.points);
-		di.uv.resize(di.points);
-		di.w.resize(di.points);
-		di.tint.resize(di.points);
-		for (uint32_t i = 0; i < di.points; i++)
-		{
-			di.pos[i] = { (pos[i].x * vInvScreenSize.x) * 2.0f - 1.0f, ((pos[i].y * vInvScreenSize.y) * 2.0f - 1.0f) * -1.0f };
-			di.uv[i] = uv[i];
-			di.tint[i] = tint[i];
-			di.w[i] = 1.0f;
-		}
-		di.mode = nDecalMode;
-		di.structure = nDecalStructure;
-		vLayers[nTargetLayer].vecDecalInstance.push_back(di);
+		DrawPolygonDecal(decal, pos.data(), nullptr, uv.data(), tint.data(), uint32_t(pos.size()));
 	}
 
 	void PixelGameEngine::DrawPolygonDecal(olc::Decal* decal, const std::vector<olc::vf2d>& pos, const std::vector<olc::vf2d>& uv, const std::vector<olc::Pixel>& colours, const olc::Pixel tint)
 	{
-		std::vector<olc::Pixel> newColours(colours.size(), olc::WHITE);
-		std::transform(colours.begin(), colours.end(), newColours.begin(),
-			[&tint](const olc::Pixel pin) {	return pin * tint; });
-		DrawPolygonDecal(decal, pos, uv, newColours);
+		DrawPolygonDecal(decal, pos.data(), nullptr, uv.data(), colours.data(), uint32_t(pos.size()), tint);
 	}
 
-
 	void PixelGameEngine::DrawPolygonDecal(olc::Decal* decal, const std::vector<olc::vf2d>& pos, const std::vector<float>& depth, const std::vector<olc::vf2d>& uv, const olc::Pixel tint)
 	{
-		DecalInstance di;
-		di.decal = decal;
-		di.points = uint32_t(pos.size());
-		di.pos.resize(di.points);
-		di.uv.resize(di.points);
-		di.w.resize(di.points);
-		di.tint.resize(di.points);
-		for (uint32_t i = 0; i < di.points; i++)
+		DrawPolygonDecal(decal, pos.data(), depth.data(), uv.data(), nullptr, uint32_t(pos.size()), tint);
+	}
+
+	void PixelGameEngine::DrawPolygonDecal(olc::Decal* decal, const std::vector<olc::vf2d>& pos, const std::vector<float>& depth, const std::vector<olc::vf2d>& uv, const std::vector<olc::Pixel>& colours, const olc::Pixel tint)
+	{
+		DrawPolygonDecal(decal, pos.data(), depth.data(), uv.data(), colours.data(), uint32_t(pos.size()), tint);
+	}
+
+	void PixelGameEngine::DrawPolygonDecal(olc::Decal* decal, const olc::vf2d* pos, const olc::vf2d* uv, const olc::Pixel* colours, uint32_t elements, const olc::Pixel tint)
+	{
+		DrawPolygonDecal(decal, pos, nullptr, uv, colours, elements, tint);
+	}
+
+	void PixelGameEngine::DrawPolygonDecal(olc::Decal* decal, const olc::vf2d* pos, const float* depth, const olc::vf2d* uv, const olc::Pixel* colours, uint32_t elements, const olc::Pixel tint)
+	{
+		DecalInstance& di = NewDecalInstance(decal, elements);
+		const olc::vf2d vUVOffset = decal ? decal->vUVOffset : olc::vf2d(0.0f, 0.0f);
+		const olc::vf2d vUVExtent = decal ? decal->vUVExtent : olc::vf2d(1.0f, 1.0f);
+		for (uint32_t i = 0; i < elements; i++)
 		{
 			di.pos[i] = { (pos[i].x * vInvScreenSize.x) * 2.0f - 1.0f, ((pos[i].y * vInvScreenSize.y) * 2.0f - 1.0f) * -1.0f };
-			di.uv[i] = uv[i];
-			di.tint[i] = tint;
-			di.w[i] = depth[i];
+			di.uv[i] = vUVOffset + uv[i] * vUVExtent;
+			di.tint[i] = colours ? colours[i] * tint : tint;
+			di.w[i] = depth ? depth[i] : 1.0f;
 		}
+	}
+
+	olc::DecalInstance& PixelGameEngine::NewDecalInstance(olc::Decal* decal, uint32_t nPoints)
+	{
+		auto& layer = vLayers[nTargetLayer];
+		auto& arena = layer.decalVerts;
+
+		// Growing within existing capacity does not allocate
+		const size_t nOffset = arena.pos.size();
+		arena.pos.resize(nOffset + nPoints);
+		arena.uv.resize(nOffset + nPoints);
+		arena.w.resize(nOffset + nPoints, 1.0f);
+		arena.tint.resize(nOffset + nPoints, olc::WHITE);
+
+		layer.vecDecalInstance.emplace_back();
+		DecalInstance& di = layer.vecDecalInstance.back();
+		di.decal = decal;
+		di.offset = uint32_t(nOffset);
+		di.points = nPoints;
+		di.pos = arena.pos.data() + nOffset;
+		di.uv = arena.uv.data() + nOffset;
+		di.w = arena.w.data() + nOffset;
+		di.tint = arena.tint.data() + nOffset;
 		di.mode = nDecalMode;
 		di.structure = nDecalStructure;
-		vLayers[nTargetLayer].vecDecalInstance.push_back(di);
+		return di;
 	}
 
-	void PixelGameEngine::DrawPolygonDecal(olc::Decal* decal, const std::vector<olc::vf2d>& pos, const std::vector<float>& depth, const std::vector<olc::vf2d>& uv, const std::vector<olc::Pixel>& colours, const olc::Pixel tint)
+	void PixelGameEngine::SubmitLayerDecals(olc::LayerDesc& layer)
 	{
-		DecalInstance di;
-		di.decal = decal;
-		di.points = uint32_t(pos.size());
-		di.pos.resize(di.points);
-		di.uv.resize(di.points);
-		di.w.resize(di.points);
-		di.tint.resize(di.points);
-		for (uint32_t i = 0; i < di.points; i++)
+		auto& arena = layer.decalVerts;
+		for (auto& di : layer.vecDecalInstance)
 		{
-			di.pos[i] = { (pos[i].x * vInvScreenSize.x) * 2.0f - 1.0f, ((pos[i].y * vInvScreenSize.y) * 2.0f - 1.0f) * -1.0f };
-			di.uv[i] = uv[i];
-			di.tint[i] = colours[i] * tint;
-			di.w[i] = depth[i];
+			// The arena may have moved since this instance was made
+			di.pos = arena.pos.data() + di.offset;
+			di.uv = arena.uv.data() + di.offset;
+			di.w = arena.w.data() + di.offset;
+			di.tint = arena.tint.data() + di.offset;
+			di.instances = arena.instances.data() + di.instanceOffset;
+			if (di.instanceCount > 0)
+				renderer->DrawDecalInstanced(di, vInvScreenSize);
+			else
+				renderer->DrawDecal(di);
 		}
-		di.mode = nDecalMode;
-		di.structure = nDecalStructure;
-		vLayers[nTargetLayer].vecDecalInstance.push_back(di);
+		renderer->Flush();
+
+		layer.vecDecalInstance.clear();
+		arena.pos.clear();
+		arena.uv.clear();
+		arena.w.clear();
+		arena.tint.clear();
+		arena.instances.clear();
+	}
+
+	void PixelGameEngine::DecalQuadCorners(olc::vf2d* p, const olc::vf2d& tl, const olc::vf2d& br)
+	{
+		p[0] = tl; p[1] = { tl.x, br.y }; p[2] = br; p[3] = { br.x, tl.y };
 	}
 
 	void PixelGameEngine::HW3D_Projection(const std::array<float, 16>& m)
@@ -3617,7 +6250,8 @@ namespace olc
 	{
 		auto m = nDecalMode;
 		nDecalMode = olc::DecalMode::WIREFRAME;
-		DrawPolygonDecal(nullptr, { pos1, pos2 }, { {0, 0}, {0,0} }, p);
+		const olc::vf2d pos[2] = { pos1, pos2 }, uv[2] = { {0, 0}, {0, 0} };
+		DrawPolygonDecal(nullptr, pos, uv, nullptr, 2, p);
 		nDecalMode = m;
 	}
 
@@ -3669,29 +6303,21 @@ namespace olc
 
 	void PixelGameEngine::DrawRotatedDecal(const olc::vf2d& pos, olc::Decal* decal, const float fAngle, const olc::vf2d& center, const olc::vf2d& scale, const olc::Pixel& tint)
 	{
-		DecalInstance di;
-		di.decal = decal;
-		di.pos.resize(4);
-		di.uv = { { 0.0f, 0.0f}, {0.0f, 1.0f}, {1.0f, 1.0f}, {1.0f, 0.0f} };
-		di.w = { 1, 1, 1, 1 };
-		di.tint = { tint, tint, tint, tint };
-		di.points = 4;
-		di.pos[0] = (olc::vf2d(0.0f, 0.0f) - center) * scale;
-		di.pos[1] = (olc::vf2d(0.0f, float(decal->sprite->height)) - center) * scale;
-		di.pos[2] = (olc::vf2d(float(decal->sprite->width), float(decal->sprite->height)) - center) * scale;
-		di.pos[3] = (olc::vf2d(float(decal->sprite->width), 0.0f) - center) * scale;
+		olc::vf2d vPos[4];
+		vPos[0] = (olc::vf2d(0.0f, 0.0f) - center) * scale;
+		vPos[1] = (olc::vf2d(0.0f, float(decal->sprite->height)) - center) * scale;
+		vPos[2] = (olc::vf2d(float(decal->sprite->width), float(decal->sprite->height)) - center) * scale;
+		vPos[3] = (olc::vf2d(float(decal->sprite->width), 0.0f) - center) * scale;
 		float c = cos(fAngle), s = sin(fAngle);
 		for (int i = 0; i < 4; i++)
 		{
-			di.pos[i] = pos + olc::vf2d(di.pos[i].x * c - di.pos[i].y * s, di.pos[i].x * s + di.pos[i].y * c);
-			di.pos[i] = di.pos[i] * vInvScreenSize * 2.0f - olc::vf2d(1.0f, 1.0f);
-			di.pos[i].y *= -1.0f;
-			di.w[i] = 1;
+			vPos[i] = pos + olc::vf2d(vPos[i].x * c - vPos[i].y * s, vPos[i].x * s + vPos[i].y * c);
+			vPos[i] = vPos[i] * vInvScreenSize * 2.0f - olc::vf2d(1.0f, 1.0f);
+			vPos[i].y *= -1.0f;
 		}
-		di.mode = nDecalMode;
-		di.structure = nDecalStructure;
-		//vLayers[nTargetLayer].vecDecalInstance.push_back(di);
 
+		const olc::vf2d uvtl = decal->vUVOffset;
+		const olc::vf2d uvbr = decal->vUVOffset + decal->vUVExtent;
 
 		GPUTask task;
 		task.decal = decal;
@@ -3699,10 +6325,10 @@ namespace olc
 		task.structure = nDecalStructure;
 		task.depth = false;
 		task.vb = {
-			{di.pos[0].x, di.pos[0].y, 0.0f, 1.0f, 0.0f, 0.0f, tint.n},
-			{di.pos[1].x, di.pos[1].y, 0.0f, 1.0f, 0.0f, 1.0f, tint.n},
-			{di.pos[2].x, di.pos[2].y, 0.0f, 1.0f, 1.0f, 1.0f, tint.n},
-			{di.pos[3].x, di.pos[3].y, 0.0f, 1.0f, 1.0f, 0.0f, tint.n},
+			{vPos[0].x, vPos[0].y, 0.0f, 1.0f, uvtl.x, uvtl.y, tint.n},
+			{vPos[1].x, vPos[1].y, 0.0f, 1.0f, uvtl.x, uvbr.y, tint.n},
+			{vPos[2].x, vPos[2].y, 0.0f, 1.0f, uvbr.x, uvbr.y, tint.n},
+			{vPos[3].x, vPos[3].y, 0.0f, 1.0f, uvbr.x, uvtl.y, tint.n},
 		};
 		vLayers[nTargetLayer].vecGPUTasks.push_back(task);
 	}
@@ -3710,12 +6336,8 @@ namespace olc
 
 	void PixelGameEngine::DrawPartialRotatedDecal(const olc::vf2d& pos, olc::Decal* decal, const float fAngle, const olc::vf2d& center, const olc::vf2d& source_pos, const olc::vf2d& source_size, const olc::vf2d& scale, const olc::Pixel& tint)
 	{
-		DecalInstance di;
-		di.decal = decal;
-		di.points = 4;
-		di.tint = { tint, tint, tint, tint };
-		di.w = { 1, 1, 1, 1 };
-		di.pos.resize(4);
+		DecalInstance& di = NewDecalInstance(decal, 4);
+		std::fill_n(di.tint, 4, tint);
 		di.pos[0] = (olc::vf2d(0.0f, 0.0f) - center) * scale;
 		di.pos[1] = (olc::vf2d(0.0f, source_size.y) - center) * scale;
 		di.pos[2] = (olc::vf2d(source_size.x, source_size.y) - center) * scale;
@@ -3728,30 +6350,38 @@ namespace olc
 			di.pos[i].y *= -1.0f;
 		}
 
-		olc::vf2d uvtl = source_pos * decal->vUVScale;
+		olc::vf2d uvtl = decal->vUVOffset + source_pos * decal->vUVScale;
 		olc::vf2d uvbr = uvtl + (source_size * decal->vUVScale);
-		di.uv = { { uvtl.x, uvtl.y }, { uvtl.x, uvbr.y }, { uvbr.x, uvbr.y }, { uvbr.x, uvtl.y } };
-		di.mode = nDecalMode;
-		di.structure = nDecalStructure;
-		vLayers[nTargetLayer].vecDecalInstance.push_back(di);
+		DecalQuadCorners(di.uv, uvtl, uvbr);
+	}
+
+	void PixelGameEngine::DrawDecalInstanced(olc::Decal* decal, const olc::InstanceData* data, uint32_t count)
+	{
+		if (decal == nullptr || count == 0) return;
+		DecalInstance& di = NewDecalInstance(decal, 0);
+		auto& vInstances = vLayers[nTargetLayer].decalVerts.instances;
+		di.instanceOffset = uint32_t(vInstances.size());
+		di.instanceCount = count;
+		di.structure = olc::DecalStructure::FAN;
+		vInstances.insert(vInstances.end(), data, data + count);
+	}
+
+	void PixelGameEngine::DrawDecalInstanced(olc::Decal* decal, const std::vector<olc::InstanceData>& data)
+	{
+		DrawDecalInstanced(decal, data.data(), uint32_t(data.size()));
 	}
 
 	void PixelGameEngine::DrawPartialWarpedDecal(olc::Decal* decal, const olc::vf2d* pos, const olc::vf2d& source_pos, const olc::vf2d& source_size, const olc::Pixel& tint)
 	{
-		DecalInstance di;
-		di.points = 4;
-		di.decal = decal;
-		di.tint = { tint, tint, tint, tint };
-		di.w = { 1, 1, 1, 1 };
-		di.pos.resize(4);
-		di.uv = { { 0.0f, 0.0f}, {0.0f, 1.0f}, {1.0f, 1.0f}, {1.0f, 0.0f} };
 		olc::vf2d center;
 		float rd = ((pos[2].x - pos[0].x) * (pos[3].y - pos[1].y) - (pos[3].x - pos[1].x) * (pos[2].y - pos[0].y));
 		if (rd != 0)
 		{
-			olc::vf2d uvtl = source_pos * decal->vUVScale;
+			DecalInstance& di = NewDecalInstance(decal, 4);
+			std::fill_n(di.tint, 4, tint);
+			olc::vf2d uvtl = decal->vUVOffset + source_pos * decal->vUVScale;
 			olc::vf2d uvbr = uvtl + (source_size * decal->vUVScale);
-			di.uv = { { uvtl.x, uvtl.y }, { uvtl.x, uvbr.y }, { uvbr.x, uvbr.y }, { uvbr.x, uvtl.y } };
+			DecalQuadCorners(di.uv, uvtl, uvbr);
 
 			rd = 1.0f / rd;
 			float rn = ((pos[3].x - pos[1].x) * (pos[0].y - pos[1].y) - (pos[3].y - pos[1].y) * (pos[0].x - pos[1].x)) * rd;
@@ -3764,9 +6394,6 @@ namespace olc
 				di.uv[i] *= q; di.w[i] *= q;
 				di.pos[i] = { (pos[i].x * vInvScreenSize.x) * 2.0f - 1.0f, ((pos[i].y * vInvScreenSize.y) * 2.0f - 1.0f) * -1.0f };
 			}
-			di.mode = nDecalMode;
-			di.structure = nDecalStructure;
-			vLayers[nTargetLayer].vecDecalInstance.push_back(di);
 		}
 	}
 
@@ -3774,17 +6401,13 @@ namespace olc
 	{
 		// Thanks Nathan Reed, a brilliant article explaining whats going on here
 		// http://www.reedbeta.com/blog/quadrilateral-interpolation-part-1/
-		DecalInstance di;
-		di.points = 4;
-		di.decal = decal;
-		di.tint = { tint, tint, tint, tint };
-		di.w = { 1, 1, 1, 1 };
-		di.pos.resize(4);
-		di.uv = { { 0.0f, 0.0f}, {0.0f, 1.0f}, {1.0f, 1.0f}, {1.0f, 0.0f} };
 		olc::vf2d center;
 		float rd = ((pos[2].x - pos[0].x) * (pos[3].y - pos[1].y) - (pos[3].x - pos[1].x) * (pos[2].y - pos[0].y));
 		if (rd != 0)
 		{
+			DecalInstance& di = NewDecalInstance(decal, 4);
+			std::fill_n(di.tint, 4, tint);
+			DecalQuadCorners(di.uv, decal->vUVOffset, decal->vUVOffset + decal->vUVExtent);
 			rd = 1.0f / rd;
 			float rn = ((pos[3].x - pos[1].x) * (pos[0].y - pos[1].y) - (pos[3].y - pos[1].y) * (pos[0].x - pos[1].x)) * rd;
 			float sn = ((pos[2].x - pos[0].x) * (pos[0].y - pos[1].y) - (pos[2].y - pos[0].y) * (pos[0].x - pos[1].x)) * rd;
@@ -3796,9 +6419,6 @@ namespace olc
 				di.uv[i] *= q; di.w[i] *= q;
 				di.pos[i] = { (pos[i].x * vInvScreenSize.x) * 2.0f - 1.0f, ((pos[i].y * vInvScreenSize.y) * 2.0f - 1.0f) * -1.0f };
 			}
-			di.mode = nDecalMode;
-			di.structure = nDecalStructure;
-			vLayers[nTargetLayer].vecDecalInstance.push_back(di);
 		}
 	}
 
@@ -3957,29 +6577,50 @@ namespace olc
 			}
 			else
 			{
-				int32_t ox = (c - 32) % 16;
-				int32_t oy = (c - 32) / 16;
+				DrawGlyph(x + sx, y + sy, c - 32, 0, 8, col, scale);
+				sx += 8 * scale;
+			}
+		}
+		SetPixelMode(m);
+	}
 
-				if (scale > 1)
-				{
-					for (uint32_t i = 0; i < 8; i++)
-						for (uint32_t j = 0; j < 8; j++)
-							if (fontRenderable.Sprite()->GetPixel(i + ox * 8, j + oy * 8).r > 0)
-								for (uint32_t is = 0; is < scale; is++)
-									for (uint32_t js = 0; js < scale; js++)
-										Draw(x + sx + (i * scale) + is, y + sy + (j * scale) + js, col);
-				}
-				else
+	void PixelGameEngine::DrawGlyph(int32_t x, int32_t y, int32_t nGlyph, int32_t nFirstCol, int32_t nCols, Pixel col, uint32_t scale)
+	{
+		if (!pDrawTarget || nGlyph < 0 || nGlyph >= 96 || nCols <= 0 || scale == 0) return;
+		if (nPixelMode == Pixel::MASK && col.a != 255) return;
+
+		// Reject glyphs entirely off the target before looking at any rows
+		const int32_t nW = pDrawTarget->width, nH = pDrawTarget->height, nScale = int32_t(scale);
+		if (x >= nW || y >= nH || x + nCols * nScale <= 0 || y + 8 * nScale <= 0) return;
+
+		// Opaque glyphs wholly on target are stored straight into memory
+		const bool bDirect = (nPixelMode == Pixel::MASK || nPixelMode == Pixel::NORMAL)
+			&& x >= 0 && y >= 0 && x + nCols * nScale <= nW && y + 8 * nScale <= nH;
+		if (bDirect) pDrawTarget->MarkDirty(x, y, x + nCols * nScale - 1, y + 8 * nScale - 1);
+
+		const uint8_t* pRows = &vFontMask[size_t(nGlyph) * 8];
+		const uint32_t nColMask = (1u << nCols) - 1;
+		for (int32_t j = 0; j < 8; j++)
+		{
+			uint32_t nBits = (uint32_t(pRows[j]) >> nFirstCol) & nColMask;
+			for (int32_t i = 0; nBits != 0; )
+			{
+				// Find the next run of set pixels along the row
+				while (!(nBits & 1)) { nBits >>= 1; i++; }
+				int32_t n = 0;
+				while (nBits & 1) { nBits >>= 1; n++; }
+
+				for (int32_t js = 0; js < nScale; js++)
 				{
-					for (uint32_t i = 0; i < 8; i++)
-						for (uint32_t j = 0; j < 8; j++)
-							if (fontRenderable.Sprite()->GetPixel(i + ox * 8, j + oy * 8).r > 0)
-								Draw(x + sx + i, y + sy + j, col);
+					const int32_t ny = y + j * nScale + js;
+					if (bDirect)
+						std::fill_n(pDrawTarget->pColData.data() + size_t(ny) * nW + x + i * nScale, n * nScale, col);
+					else
+						SpanFill(x + i * nScale, x + (i + n) * nScale - 1, ny, col);
 				}
-				sx += 8 * scale;
+				i += n;
 			}
 		}
-		SetPixelMode(m);
 	}
 
 	olc::vi2d PixelGameEngine::GetTextSizeProp(const std::string& s)
@@ -4027,26 +6668,10 @@ namespace olc
 			}
 			else
 			{
-				int32_t ox = (c - 32) % 16;
-				int32_t oy = (c - 32) / 16;
-
-				if (scale > 1)
-				{
-					for (int32_t i = 0; i < vFontSpacing[c - 32].y; i++)
-						for (int32_t j = 0; j < 8; j++)
-							if (fontRenderable.Sprite()->GetPixel(i + ox * 8 + vFontSpacing[c - 32].x, j + oy * 8).r > 0)
-								for (int32_t is = 0; is < int(scale); is++)
-									for (int32_t js = 0; js < int(scale); js++)
-										Draw(x + sx + (i * scale) + is, y + sy + (j * scale) + js, col);
-				}
-				else
-				{
-					for (int32_t i = 0; i < vFontSpacing[c - 32].y; i++)
-						for (int32_t j = 0; j < 8; j++)
-							if (fontRenderable.Sprite()->GetPixel(i + ox * 8 + vFontSpacing[c - 32].x, j + oy * 8).r > 0)
-								Draw(x + sx + i, y + sy + j, col);
-				}
-				sx += vFontSpacing[c - 32].y * scale;
+				const int32_t nGlyph = c - 32;
+				if (nGlyph < 0 || nGlyph >= int32_t(vFontSpacing.size())) continue;
+				DrawGlyph(x + sx, y + sy, nGlyph, vFontSpacing[nGlyph].x, vFontSpacing[nGlyph].y, col, scale);
+				sx += vFontSpacing[nGlyph].y * scale;
 			}
 		}
 		SetPixelMode(m);
@@ -4073,6 +6698,7 @@ namespace olc
 		fBlendFactor = fBlend;
 		if (fBlendFactor < 0.0f) fBlendFactor = 0.0f;
 		if (fBlendFactor > 1.0f) fBlendFactor = 1.0f;
+		nBlendFactor = uint8_t(fBlendFactor * 255.0f + 0.5f);
 	}
 
 	std::stringstream& PixelGameEngine::ConsoleOut()
@@ -4313,6 +6939,11 @@ namespace olc
 		UNUSED(fElapsedTime);  return false;
 	}
 
+	bool PixelGameEngine::OnFixedUpdate(float fFixedTime)
+	{
+		UNUSED(fFixedTime);  return true;
+	}
+
 	bool PixelGameEngine::OnUserDestroy()
 	{
 		return true;
@@ -4461,6 +7092,8 @@ namespace olc
 
 	void PixelGameEngine::olc_Terminate()
 	{
+		// This can come from the window's thread, which doesnt own the GL context,
+		// so a pipelined frame still pending is presented as the engine loop stops
 		bAtomActive = false;
 	}
 
@@ -4482,6 +7115,7 @@ namespace olc
 		{
 			// Run as fast as possible
 			while (bAtomActive) { olc_CoreUpdate(); }
+			olc_PresentPendingFrame();
 
 			// Allow the user to free resources if they have overrided the destroy function
 			if (!OnUserDestroy())
@@ -4508,8 +7142,9 @@ namespace olc
 		vLayers[0].bShow = true;
 		SetDrawTarget(nullptr);
 
-		m_tp1 = std::chrono::system_clock::now();
-		m_tp2 = std::chrono::system_clock::now();
+		m_tp1 = std::chrono::steady_clock::now();
+		m_tp2 = std::chrono::steady_clock::now();
+		m_tpNextFrame = m_tp1;
 	}
 
 
@@ -4518,6 +7153,11 @@ namespace olc
 		bManualRenderEnable = bEnable;
 	}
 
+	void PixelGameEngine::adv_PipelinedFramesEnable(const bool bEnable)
+	{
+		bPipelinedFrames = bEnable;
+	}
+
 	void PixelGameEngine::adv_HardwareClip(const bool bClipAndScale, const olc::vi2d& viewPos, const olc::vi2d& viewSize, const bool bClear)
 	{
 		olc::vf2d vNewSize = olc::vf2d(viewSize) / olc::vf2d(vScreenSize);
@@ -4547,7 +7187,7 @@ namespace olc
 				renderer->ApplyTexture(layer.pDrawTarget.Decal()->id);
 				if (!bSuspendTextureTransfer)
 				{
-					layer.pDrawTarget.Decal()->Update();
+					layer.pDrawTarget.Decal()->UpdateDirty();
 					layer.bUpdate = false;
 				}
 
@@ -4567,49 +7207,114 @@ namespace olc
 					vScreenSpacePos.y - (2.0f * (float(layer.pDrawTarget.Sprite()->height) * vInvScreenSize.y)) * layer.vScale.y
 				};
 
+				olc::vf2d vPos[4], vUV[4];
+				float fW[4] = { 1, 1, 1, 1 };
+				olc::Pixel pTint[4] = { olc::WHITE, olc::WHITE, olc::WHITE, olc::WHITE };
+				DecalQuadCorners(vPos, vScreenSpacePos, vScreenSpaceDim);
+				DecalQuadCorners(vUV, { 0.0f, 0.0f }, { 1.0f, 1.0f });
+
 				DecalInstance di;
 				di.decal = layer.pDrawTarget.Decal();
 				di.points = 4;
-				di.tint = { olc::WHITE, olc::WHITE, olc::WHITE, olc::WHITE };
-				di.pos = { { vScreenSpacePos.x, vScreenSpacePos.y }, { vScreenSpacePos.x, vScreenSpaceDim.y }, { vScreenSpaceDim.x, vScreenSpaceDim.y }, { vScreenSpaceDim.x, vScreenSpacePos.y } };
-				di.uv = { { 0.0f, 0.0f}, {0.0f, 1.0f}, {1.0f, 1.0f}, {1.0f, 0.0f} };
-				di.w = { 1, 1, 1, 1 };
+				di.pos = vPos; di.uv = vUV; di.w = fW; di.tint = pTint;
 				di.mode = DecalMode::NORMAL;
 				di.structure = DecalStructure::FAN;
 				renderer->DrawDecal(di);
+				renderer->Flush();
 			}
 			else
 			{
 				// Mwa ha ha.... Have Fun!!!
 				layer.funcHook();
+				renderer->InvalidateState();
 			}
 		}
 	}
 
-	void PixelGameEngine::adv_FlushLayerDecals(const size_t nLayerID)
+	void PixelGameEngine::adv_FlushLayerDecals(const size_t nLayerID)
+	{
+		// Display Decals in order for this layer
+		SubmitLayerDecals(vLayers[nLayerID]);
+	}
+
+	void PixelGameEngine::adv_FlushLayerGPUTasks(const size_t nLayerID)
+	{
+		// Display Decals in order for this layer
+		auto& layer = vLayers[nLayerID];
+		for (auto& decal : layer.vecGPUTasks)
+			renderer->DoGPUTask(decal);
+		layer.vecGPUTasks.clear();
+	}
+
+
+
+	void PixelGameEngine::olc_PaceFrame()
+	{
+#if defined(OLC_PLATFORM_EMSCRIPTEN)
+		// The browser calls each frame, so blocking here would only stall it. Ask it
+		// to call at the limited rate instead, which only works once the main loop
+		// is running, as it is by now
+		if (m_durLoopPeriod != m_durFramePeriod)
+		{
+			m_durLoopPeriod = m_durFramePeriod;
+			if (m_durFramePeriod.count() == 0)
+				emscripten_set_main_loop_timing(EM_TIMING_RAF, 1);
+			else
+				emscripten_set_main_loop_timing(EM_TIMING_SETTIMEOUT,
+					std::max(1, int(std::chrono::duration<double, std::milli>(m_durFramePeriod).count() + 0.5)));
+		}
+#else
+		if (m_durFramePeriod.count() == 0) return;
+
+		// More than a frame behind, so start afresh rather than rush to catch up
+		auto tpNow = std::chrono::steady_clock::now();
+		if (tpNow - m_tpNextFrame > m_durFramePeriod) m_tpNextFrame = tpNow;
+
+		// Sleep while there is comfortably time to, learning how late sleeps wake
+		// up as we go. Late wakes pull the slack up quickly and it drifts back
+		// down otherwise, so it settles near the worst of the usual wakes without
+		// chasing the odd really bad one, which would leave us spinning
+		while (m_tpNextFrame - tpNow > m_durSleepSlack)
+		{
+			const auto durSleep = m_tpNextFrame - tpNow - m_durSleepSlack;
+			std::this_thread::sleep_for(durSleep);
+			const auto tpWoke = std::chrono::steady_clock::now();
+			const auto durLate = tpWoke - tpNow - durSleep;
+			if (durLate > m_durSleepSlack)
+				m_durSleepSlack += (durLate - m_durSleepSlack) / 8;
+			else
+				m_durSleepSlack -= m_durSleepSlack / 64;
+			tpNow = tpWoke;
+		}
+
+		// Then spin out the rest
+		while (tpNow < m_tpNextFrame)
+		{
+			std::this_thread::yield();
+			tpNow = std::chrono::steady_clock::now();
+		}
+
+		m_tpNextFrame += m_durFramePeriod;
+#endif
+	}
+
+	void PixelGameEngine::olc_PresentPendingFrame()
 	{
-		// Display Decals in order for this layer
-		auto& layer = vLayers[nLayerID];
-		for (auto& decal : layer.vecDecalInstance)
-			renderer->DrawDecal(decal);
-		layer.vecDecalInstance.clear();
+		if (!bFramePending) return;
+		renderer->DisplayFrame();
+		bFramePending = false;
 	}
 
-	void PixelGameEngine::adv_FlushLayerGPUTasks(const size_t nLayerID)
+	void PixelGameEngine::olc_CoreUpdate()
 	{
-		// Display Decals in order for this layer
-		auto& layer = vLayers[nLayerID];
-		for (auto& decal : layer.vecGPUTasks)
-			renderer->DoGPUTask(decal);
-		layer.vecGPUTasks.clear();
-	}
-
+		profiler.BeginFrame();
 
+		profiler.BeginZone("Frame Pacing");
+		olc_PaceFrame();
+		profiler.EndZone();
 
-	void PixelGameEngine::olc_CoreUpdate()
-	{
 		// Handle Timing
-		m_tp2 = std::chrono::system_clock::now();
+		m_tp2 = std::chrono::steady_clock::now();
 		std::chrono::duration<float> elapsedTime = m_tp2 - m_tp1;
 		m_tp1 = m_tp2;
 
@@ -4621,6 +7326,7 @@ namespace olc
 			fElapsedTime = 0.0f;
 
 		// Some platforms will need to check for events
+		profiler.BeginZone("Input");
 		platform->HandleSystemEvent();
 
 		// Compare hardware input states from previous frame
@@ -4668,16 +7374,60 @@ namespace olc
 		{
 			UpdateTextEntry();
 		}
+		profiler.EndZone();
+
+		// Handle Fixed Updates
+		if (fFixedStep > 0.0f)
+		{
+			profiler.BeginZone("OnFixedUpdate");
+			fFixedAccumulator += fElapsedTime;
+			uint32_t nSteps = 0;
+			while (fFixedAccumulator >= fFixedStep && nSteps < nFixedMaxSteps)
+			{
+				float fFixedTime = fFixedStep;
+				bool bContinue = true;
+				bool bExtensionBlockStep = false;
+				for (auto& ext : vExtensions) bExtensionBlockStep |= ext->OnBeforeFixedUpdate(fFixedTime);
+				if (!bExtensionBlockStep)
+				{
+					bContinue = OnFixedUpdate(fFixedTime);
+				}
+				for (auto& ext : vExtensions) ext->OnAfterFixedUpdate(fFixedTime);
+
+				fFixedAccumulator -= fFixedStep;
+				nSteps++;
+
+				// The user wants out, so dont run any more steps
+				if (!bContinue)
+				{
+					bAtomActive = false;
+					break;
+				}
+			}
+
+			// Too far behind to catch up, so let the missed steps go rather
+			// than spend ever longer frames trying to
+			if (fFixedAccumulator >= fFixedStep)
+				fFixedAccumulator = std::fmod(fFixedAccumulator, fFixedStep);
+
+			fFixedAlpha = fFixedAccumulator / fFixedStep;
+			profiler.EndZone();
+		}
 
 		// Handle Frame Update
 		bool bExtensionBlockFrame = false;
+		profiler.BeginZone("PGEX OnBeforeUserUpdate");
 		for (auto& ext : vExtensions) bExtensionBlockFrame |= ext->OnBeforeUserUpdate(fElapsedTime);
+		profiler.EndZone();
 		if (!bExtensionBlockFrame)
 		{
+			profiler.BeginZone("OnUserUpdate");
 			if (!OnUserUpdate(fElapsedTime)) bAtomActive = false;
-
+			profiler.EndZone();
 		}
+		profiler.BeginZone("PGEX OnAfterUserUpdate");
 		for (auto& ext : vExtensions) ext->OnAfterUserUpdate(fElapsedTime);
+		profiler.EndZone();
 
 		// Clear prior keypress cache
 		vKeyPressCache[nKeyPressCacheTarget ^ 0x01].clear();
@@ -4689,8 +7439,19 @@ namespace olc
 			vViewPos = { 0,0 };
 		}
 
+		// A pipelined frame is only presented now, the GPU having had all of
+		// the update above to draw it
+		const bool bPipeline = bPipelinedFrames && !bManualRenderEnable;
+		if (bFramePending)
+		{
+			profiler.BeginZone("DisplayFrame");
+			olc_PresentPendingFrame();
+			profiler.EndZone();
+		}
+
 		if (!bManualRenderEnable)
 		{
+			profiler.BeginZone("Render");
 			if (bConsoleShow)
 			{
 				SetDrawTarget((uint8_t)0);
@@ -4713,36 +7474,61 @@ namespace olc
 				{
 					if (layer->funcHook == nullptr)
 					{
+						profiler.CountLayer(size_t(std::distance(layer, vLayers.rend()) - 1),
+							uint32_t(layer->vecDecalInstance.size()), uint32_t(layer->vecGPUTasks.size()));
+
+						profiler.BeginZone("Layer Upload");
 						renderer->ApplyTexture(layer->pDrawTarget.Decal()->id);
 						if (!bSuspendTextureTransfer && layer->bUpdate)
 						{
-							layer->pDrawTarget.Decal()->Update();
+							layer->pDrawTarget.Decal()->UpdateDirty();
 							layer->bUpdate = false;
 						}
 
 						renderer->DrawLayerQuad(layer->vOffset, layer->vScale, layer->tint);
+						profiler.EndZone();
 
 						// Do GPU Tasks - 2D/3D Objects
+						profiler.BeginZone("GPU Tasks");
 						for (auto& task : layer->vecGPUTasks)
 							renderer->DoGPUTask(task);
 						layer->vecGPUTasks.clear();
+						profiler.EndZone();
 
 						// Display Decals in order for this layer
-						for (auto& decal : layer->vecDecalInstance)
-							renderer->DrawDecal(decal);
-						layer->vecDecalInstance.clear();
+						profiler.BeginZone("Decals");
+						SubmitLayerDecals(*layer);
+						profiler.EndZone();
 					}
 					else
 					{
 						// Mwa ha ha.... Have Fun!!!
 						layer->funcHook();
+						renderer->InvalidateState();
 					}
 				}
 			}
+			profiler.EndZone();
 		}
 
-		// Present Graphics to screen
-		renderer->DisplayFrame();
+		// Present Graphics to screen, or set the GPU going on them and present
+		// next time round
+		if (bPipeline)
+		{
+			profiler.BeginZone("SubmitFrame");
+			renderer->SubmitFrame();
+			profiler.EndZone();
+			bFramePending = true;
+
+			// Nothing will come round to present it if the engine is stopping
+			if (!bAtomActive) olc_PresentPendingFrame();
+		}
+		else
+		{
+			profiler.BeginZone("DisplayFrame");
+			renderer->DisplayFrame();
+			profiler.EndZone();
+		}
 
 		if (bResizeRequested)
 		{
@@ -4762,6 +7548,8 @@ namespace olc
 			platform->SetWindowTitle(sTitle);
 			nFrameCount = 0;
 		}
+
+		profiler.EndFrame();
 	}
 
 	void PixelGameEngine::olc_ConstructFontSheet()
@@ -4805,6 +7593,16 @@ namespace olc
 
 		fontRenderable.Decal()->Update();
 
+		for (int32_t g = 0; g < 96; g++)
+			for (int32_t j = 0; j < 8; j++)
+			{
+				uint8_t nRow = 0;
+				for (int32_t i = 0; i < 8; i++)
+					if (fontRenderable.Sprite()->GetPixel((g % 16) * 8 + i, (g / 16) * 8 + j).r > 0)
+						nRow |= uint8_t(1 << i);
+				vFontMask[size_t(g) * 8 + j] = nRow;
+			}
+
 		constexpr std::array<uint8_t, 96> vSpacing = { {
 			0x03,0x25,0x16,0x08,0x07,0x08,0x08,0x04,0x15,0x15,0x08,0x07,0x15,0x07,0x24,0x08,
 			0x08,0x17,0x08,0x08,0x08,0x08,0x08,0x08,0x08,0x08,0x24,0x15,0x06,0x07,0x16,0x17,
@@ -4946,6 +7744,8 @@ namespace olc
 	void PGEX::OnAfterUserCreate() {}
 	bool PGEX::OnBeforeUserUpdate(float& fElapsedTime) { return false; }
 	void PGEX::OnAfterUserUpdate(float fElapsedTime) {}
+	bool PGEX::OnBeforeFixedUpdate(float& fFixedTime) { UNUSED(fFixedTime); return false; }
+	void PGEX::OnAfterFixedUpdate(float fFixedTime) { UNUSED(fFixedTime); }
 
 	// Need a couple of statics as these are singleton instances
 	// read from multiple locations
@@ -4954,6 +7754,45 @@ namespace olc
 	olc::PixelGameEngine* olc::Platform::ptrPGE = nullptr;
 	olc::PixelGameEngine* olc::Renderer::ptrPGE = nullptr;
 	std::unique_ptr<ImageLoader> olc::Sprite::loader = nullptr;
+
+	void Renderer::DrawDecalInstanced(const olc::DecalInstance& decal, const olc::vf2d& vInvScreen)
+	{
+		static const olc::vf2d vCorner[4] = { { 0.0f, 0.0f }, { 0.0f, 1.0f }, { 1.0f, 1.0f }, { 1.0f, 0.0f } };
+		const olc::vf2d vNDC = vInvScreen * 2.0f;
+		const olc::vf2d vDecalSize = { float(decal.decal->sprite->width), float(decal.decal->sprite->height) };
+
+		olc::vf2d vPos[4], vUV[4];
+		float fW[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+		olc::Pixel pTint[4];
+
+		olc::DecalInstance di;
+		di.decal = decal.decal;
+		di.points = 4;
+		di.pos = vPos; di.uv = vUV; di.w = fW; di.tint = pTint;
+		di.mode = decal.mode;
+		di.structure = olc::DecalStructure::FAN;
+
+		for (uint32_t n = 0; n < decal.instanceCount; n++)
+		{
+			const olc::InstanceData& inst = decal.instances[n];
+			const bool bWhole = inst.source_size.x == 0.0f && inst.source_size.y == 0.0f;
+			const olc::vf2d vSize = bWhole ? vDecalSize : inst.source_size;
+			const olc::vf2d uvtl = decal.decal->vUVOffset + (bWhole ? olc::vf2d(0.0f, 0.0f) : inst.source_pos) * decal.decal->vUVScale;
+			const olc::vf2d uvsz = vSize * decal.decal->vUVScale;
+			const float c = std::cos(inst.fAngle), s = std::sin(inst.fAngle);
+
+			for (int i = 0; i < 4; i++)
+			{
+				const olc::vf2d l = (vCorner[i] * vSize - inst.center) * inst.scale;
+				const olc::vf2d p = inst.pos + olc::vf2d(l.x * c - l.y * s, l.x * s + l.y * c);
+				vPos[i] = { p.x * vNDC.x - 1.0f, 1.0f - p.y * vNDC.y };
+				vUV[i] = uvtl + vCorner[i] * uvsz;
+				pTint[i] = inst.tint;
+			}
+
+			DrawDecal(di);
+		}
+	}
 };
 #pragma endregion 
 
@@ -4973,6 +7812,8 @@ namespace olc
 		virtual void	   SetDecalMode(const olc::DecalMode& mode) {}
 		virtual void       DrawLayerQuad(const olc::vf2d& offset, const olc::vf2d& scale, const olc::Pixel tint) {}
 		virtual void       DrawDecal(const olc::DecalInstance& decal) {}
+		virtual void       DoGPUTask(const olc::GPUTask& task) {}
+		virtual void       Set3DProjection(const std::array<float, 16>& mat) {}
 		virtual uint32_t   CreateTexture(const uint32_t width, const uint32_t height, const bool filtered = false, const bool clamp = true) { return 1; };
 		virtual void       UpdateTexture(uint32_t id, olc::Sprite* spr) {}
 		virtual void       ReadTexture(uint32_t id, olc::Sprite* spr) {}
@@ -5047,8 +7888,8 @@ namespace olc
 			int w = 0, h = 0, cmp = 0;
 			if (pack != nullptr)
 			{
-				ResourceBuffer rb = pack->GetFileBuffer(sImageFile);
-				bytes = stbi_load_from_memory((unsigned char*)rb.vMemory.data(), int(rb.vMemory.size()), &w, &h, &cmp, 4);
+				ResourceView rv = pack->GetFileView(sImageFile);
+				bytes = stbi_load_from_memory(rv.data(), int(rv.size()), &w, &h, &cmp, 4);
 			}
 			else
 			{
@@ -5067,7 +7908,7 @@ namespace olc
 
 		olc::rcode SaveImageResource(olc::Sprite* spr, const std::string& sImageFile) override
 		{
-			return olc::rcode::OK;
+			return SaveEncodedImage(spr, sImageFile);
 		}
 	};
 }
@@ -5266,6 +8107,11 @@ namespace olc
 #endif
 		}
 
+		void SubmitFrame() override
+		{
+			glFlush();
+		}
+
 		void PrepareDrawing() override
 		{
 
@@ -5355,26 +8201,12 @@ namespace olc
 
 
 
-			if (decal.depth)
-			{
-
-				// Render as 3D Spatial Entity
-				for (uint32_t n = 0; n < decal.points; n++)
-				{
-					glColor4ub(decal.tint[n].r, decal.tint[n].g, decal.tint[n].b, decal.tint[n].a);
-					glTexCoord4f(decal.uv[n].x, decal.uv[n].y, 0.0f, decal.w[n]);
-					glVertex3f(decal.pos[n].x, decal.pos[n].y, decal.z[n]);
-				}
-			}
-			else
+			// Render as 2D Spatial entity, 3D work goes through GPUTasks
+			for (uint32_t n = 0; n < decal.points; n++)
 			{
-				// Render as 2D Spatial entity
-				for (uint32_t n = 0; n < decal.points; n++)
-				{
-					glColor4ub(decal.tint[n].r, decal.tint[n].g, decal.tint[n].b, decal.tint[n].a);
-					glTexCoord4f(decal.uv[n].x, decal.uv[n].y, 0.0f, decal.w[n]);
-					glVertex2f(decal.pos[n].x, decal.pos[n].y);
-				}
+				glColor4ub(decal.tint[n].r, decal.tint[n].g, decal.tint[n].b, decal.tint[n].a);
+				glTexCoord4f(decal.uv[n].x, decal.uv[n].y, 0.0f, decal.w[n]);
+				glVertex2f(decal.pos[n].x, decal.pos[n].y);
 			}
 
 			glEnd();
@@ -5538,12 +8370,20 @@ namespace olc
 		void UpdateTexture(uint32_t id, olc::Sprite* spr) override
 		{
 			UNUSED(id);
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, spr->width, spr->height, 0, GL_RGBA, GL_UNSIGNED_BYTE, spr->GetData());
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, spr->width, spr->height, 0, GL_RGBA, GL_UNSIGNED_BYTE, spr->pColData.data());
+		}
+
+		void UpdateTextureRegion(uint32_t id, olc::Sprite* spr, const olc::vi2d& pos, const olc::vi2d& size) override
+		{
+			UNUSED(id);
+			glPixelStorei(GL_UNPACK_ROW_LENGTH, spr->width);
+			glTexSubImage2D(GL_TEXTURE_2D, 0, pos.x, pos.y, size.x, size.y, GL_RGBA, GL_UNSIGNED_BYTE, spr->pColData.data() + size_t(pos.y) * spr->width + pos.x);
+			glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
 		}
 
 		void ReadTexture(uint32_t id, olc::Sprite* spr) override
 		{
-			glReadPixels(0, 0, spr->width, spr->height, GL_RGBA, GL_UNSIGNED_BYTE, spr->GetData());
+			glReadPixels(0, 0, spr->width, spr->height, GL_RGBA, GL_UNSIGNED_BYTE, spr->pColData.data());
 		}
 
 		void ApplyTexture(uint32_t id) override
@@ -5701,6 +8541,7 @@ namespace olc
 		locAttachShader_t* locAttachShader = nullptr;
 		locBindBuffer_t* locBindBuffer = nullptr;
 		locBufferData_t* locBufferData = nullptr;
+		locBufferSubData_t* locBufferSubData = nullptr;
 		locGenBuffers_t* locGenBuffers = nullptr;
 		locVertexAttribPointer_t* locVertexAttribPointer = nullptr;
 		locEnableVertexAttribArray_t* locEnableVertexAttribArray = nullptr;
@@ -5713,13 +8554,34 @@ namespace olc
 		locUniformMatrix4fv_t* locUniformMatrix4fv = nullptr;
 		locUniform1i_t* locUniform1i = nullptr;
 		locUniform4fv_t* locUniform4fv = nullptr;
+		locUniform2fv_t* locUniform2fv = nullptr;
+		locVertexAttribDivisor_t* locVertexAttribDivisor = nullptr;
+		locDrawArraysInstanced_t* locDrawArraysInstanced = nullptr;
+#if !defined(OLC_PLATFORM_EMSCRIPTEN)
+		locMapBufferRange_t* locMapBufferRange = nullptr;
+		locUnmapBuffer_t* locUnmapBuffer = nullptr;
+		locFenceSync_t* locFenceSync = nullptr;
+		locClientWaitSync_t* locClientWaitSync = nullptr;
+		locDeleteSync_t* locDeleteSync = nullptr;
+#endif
 
 		uint32_t m_nFS = 0;
 		uint32_t m_nVS = 0;
 		uint32_t m_nQuadShader = 0;
 		uint32_t m_vbQuad = 0;
+		uint32_t m_ibQuad = 0;
 		uint32_t m_vaQuad = 0;
 
+		// Instanced decals have their own program, which builds each quad from
+		// gl_VertexID and one InstanceData read per instance
+		uint32_t m_nInstVS = 0;
+		uint32_t m_nInstShader = 0;
+		uint32_t m_vbInstance = 0;
+		uint32_t m_vaInstance = 0;
+		uint32_t m_uniInstNDC = 0;
+		uint32_t m_uniInstSize = 0;
+		uint32_t m_uniInstUV = 0;
+
 		uint32_t m_uniMVP = 0;
 		uint32_t m_uniIs3D = 0;
 		uint32_t m_uniTint = 0;
@@ -5733,7 +8595,183 @@ namespace olc
 
 		std::array<float, 16> matProjection = { {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1} };
 
-		locVertex pVertexMem[OLC_MAX_VERTS];
+		// All geometry is streamed through one vertex buffer and one index
+		// buffer, each written front to back as a ring. When a ring fills,
+		// its storage is orphaned and writing starts again from the front
+		struct StreamRing
+		{
+			uint32_t nTarget = 0;
+			uint32_t nBuffer = 0;
+			size_t nElementSize = 0;
+			size_t nCapacity = 0;
+			size_t nHead = 0;
+		};
+		StreamRing m_streamVerts = { 0x8892, 0, sizeof(locVertex), 65536, 0 };
+		StreamRing m_streamIndices = { 0x8893, 0, sizeof(uint32_t), 131072, 0 };
+		StreamRing m_streamInstances = { 0x8892, 0, sizeof(olc::InstanceData), 16384, 0 };
+
+		// Consecutive decals with the same texture, blend mode and primitive
+		// are gathered here as indexed lists, then drawn with a single call
+		std::vector<locVertex> vBatchVerts;
+		std::vector<uint32_t> vBatchIndices;
+		uint32_t nBatchTexture = 0;
+		olc::DecalMode nBatchMode = olc::DecalMode::NORMAL;
+		bool bBatchLines = false;
+
+		// Everything set through the helpers below is remembered, so calls that
+		// would not change anything are skipped. Unknown values always go through
+		template<typename T> struct Cached { T value{}; bool bKnown = false; };
+		struct StateCache
+		{
+			Cached<uint32_t> nTexture, nProgram, nVertexArray, nArrayBuffer, nElementBuffer;
+			Cached<bool> bBlend, bDepthTest, bCullFace;
+			Cached<GLenum> nCullFace, nDepthFunc;
+			Cached<int32_t> nIs3D;
+			Cached<std::array<float, 4>> fTint, fInstUV;
+			Cached<std::array<float, 16>> fMVP;
+			Cached<std::array<float, 2>> fInstNDC, fInstSize;
+		};
+		StateCache m_state;
+		olc::RendererStats m_statsFrame, m_statsLast;
+
+		template<typename T> bool Changed(Cached<T>& c, const T& v)
+		{
+			if (c.bKnown && c.value == v)
+			{
+				m_statsFrame.nStateCallsSkipped++;
+				return false;
+			}
+			c.value = v; c.bKnown = true;
+			m_statsFrame.nStateCalls++;
+			return true;
+		}
+
+		void BindTexture(uint32_t id)
+		{
+			if (Changed(m_state.nTexture, id)) glBindTexture(GL_TEXTURE_2D, id);
+		}
+
+		void UseProgram(uint32_t id)
+		{
+			if (Changed(m_state.nProgram, id)) locUseProgram(id);
+		}
+
+		void BindVertexArray(uint32_t id)
+		{
+			// The element buffer binding belongs to the vertex array
+			if (Changed(m_state.nVertexArray, id)) { locBindVertexArray(id); m_state.nElementBuffer.bKnown = false; }
+		}
+
+		void BindBuffer(uint32_t nTarget, uint32_t id)
+		{
+			if (Changed(nTarget == 0x8893 ? m_state.nElementBuffer : m_state.nArrayBuffer, id)) locBindBuffer(nTarget, id);
+		}
+
+		void SetCapability(GLenum nCap, Cached<bool>& c, bool bEnable)
+		{
+			if (Changed(c, bEnable)) { if (bEnable) glEnable(nCap); else glDisable(nCap); }
+		}
+
+		// Shared state of the 2D quad paths
+		void UseQuadShader(const olc::Pixel tint = olc::WHITE)
+		{
+			UseProgram(m_nQuadShader);
+			BindVertexArray(m_vaQuad);
+			SetCapability(GL_CULL_FACE, m_state.bCullFace, false);
+			SetCapability(GL_DEPTH_TEST, m_state.bDepthTest, false);
+			if (Changed(m_state.nIs3D, 0)) locUniform1i(m_uniIs3D, 0);
+			const std::array<float, 4> f = { float(tint.r) / 255.0f, float(tint.g) / 255.0f, float(tint.b) / 255.0f, float(tint.a) / 255.0f };
+			if (Changed(m_state.fTint, f)) locUniform4fv(m_uniTint, 1, f.data());
+		}
+
+		void DrawArrays(GLenum nMode, GLint nFirst, GLsizei nCount)
+		{
+			glDrawArrays(nMode, nFirst, nCount);
+			m_statsFrame.nDrawCalls++;
+		}
+
+		size_t Stream(StreamRing& ring, const void* pData, size_t nCount)
+		{
+			BindBuffer(ring.nTarget, ring.nBuffer);
+			if (nCount > ring.nCapacity)
+			{
+				while (ring.nCapacity < nCount) ring.nCapacity *= 2;
+				ring.nHead = ring.nCapacity;
+			}
+
+			if (ring.nHead + nCount > ring.nCapacity)
+			{
+				locBufferData(ring.nTarget, GLsizeiptr(ring.nCapacity * ring.nElementSize), nullptr, 0x88E0);
+				ring.nHead = 0;
+			}
+
+			const size_t nFirst = ring.nHead;
+			locBufferSubData(ring.nTarget, GLintptr(nFirst * ring.nElementSize), GLsizeiptr(nCount * ring.nElementSize), pData);
+			ring.nHead += nCount;
+			return nFirst;
+		}
+
+#if !defined(OLC_PLATFORM_EMSCRIPTEN)
+		// Asynchronous transfers go through pixel buffers, three each way, used
+		// in turn. A fence marks when the GPU is done with each one. WebGL2 has
+		// both, but cant map buffers and cant block in glClientWaitSync(), so
+		// Emscripten builds keep the synchronous defaults
+		struct PixelTransfer
+		{
+			uint32_t nBuffer = 0;
+			GLsync fence = nullptr;
+			uint32_t nTicket = 0;
+			olc::Sprite* pSprite = nullptr;
+			olc::vi2d vSize;
+		};
+		std::array<PixelTransfer, 3> m_pboUpload;
+		std::array<PixelTransfer, 3> m_pboRead;
+		size_t m_nNextUpload = 0;
+		size_t m_nNextRead = 0;
+		uint32_t m_nNextTicket = 1;
+
+		bool WaitTransfer(PixelTransfer& t, bool bWait)
+		{
+			if (t.fence == nullptr) return true;
+			// 0x911A GL_ALREADY_SIGNALED, 0x911C GL_CONDITION_SATISFIED, 0x911D GL_WAIT_FAILED
+			GLenum nResult = locClientWaitSync(t.fence, 0x00000001, 0);
+			while (bWait && nResult != 0x911A && nResult != 0x911C && nResult != 0x911D)
+				nResult = locClientWaitSync(t.fence, 0x00000001, 1000000);
+			if (nResult != 0x911A && nResult != 0x911C && nResult != 0x911D) return false;
+			locDeleteSync(t.fence);
+			t.fence = nullptr;
+			return true;
+		}
+
+		void FinishRead(PixelTransfer& t)
+		{
+			// The sprite may have been resized while waiting, so copy what fits
+			if (t.pSprite && t.pSprite->Size() == t.vSize)
+			{
+				locBindBuffer(0x88EB, t.nBuffer);
+				const size_t nBytes = size_t(t.vSize.x) * t.vSize.y * sizeof(olc::Pixel);
+				const void* pData = locMapBufferRange(0x88EB, 0, GLsizeiptr(nBytes), 0x0001);
+				if (pData) std::memcpy(t.pSprite->pColData.data(), pData, nBytes);
+				locUnmapBuffer(0x88EB);
+				locBindBuffer(0x88EB, 0);
+			}
+			t.pSprite = nullptr;
+			t.nTicket = 0;
+		}
+
+		PixelTransfer& NextTransfer(std::array<PixelTransfer, 3>& ring, size_t& nNext)
+		{
+			// Usually long finished, as it was last used two transfers ago
+			PixelTransfer& t = ring[nNext];
+			nNext = (nNext + 1) % ring.size();
+			WaitTransfer(t, true);
+			if (t.pSprite) FinishRead(t);
+			if (t.nBuffer == 0) locGenBuffers(1, &t.nBuffer);
+			t.nTicket = m_nNextTicket++;
+			if (m_nNextTicket == 0) m_nNextTicket = 1;
+			return t;
+		}
+#endif
 
 		olc::Renderable rendBlankQuad;
 
@@ -5855,6 +8893,7 @@ namespace olc
 			locAttachShader = OGL_LOAD(locAttachShader_t, glAttachShader);
 			locBindBuffer = OGL_LOAD(locBindBuffer_t, glBindBuffer);
 			locBufferData = OGL_LOAD(locBufferData_t, glBufferData);
+			locBufferSubData = OGL_LOAD(locBufferSubData_t, glBufferSubData);
 			locGenBuffers = OGL_LOAD(locGenBuffers_t, glGenBuffers);
 			locVertexAttribPointer = OGL_LOAD(locVertexAttribPointer_t, glVertexAttribPointer);
 			locEnableVertexAttribArray = OGL_LOAD(locEnableVertexAttribArray_t, glEnableVertexAttribArray);
@@ -5862,6 +8901,7 @@ namespace olc
 			locGetShaderInfoLog = OGL_LOAD(locGetShaderInfoLog_t, glGetShaderInfoLog);
 			locUniform1i = OGL_LOAD(locUniform1i_t, glUniform1i);
 			locUniform4fv = OGL_LOAD(locUniform4fv_t, glUniform4fv);
+			locUniform2fv = OGL_LOAD(locUniform2fv_t, glUniform2fv);
 			locUniformMatrix4fv = OGL_LOAD(locUniformMatrix4fv_t, glUniformMatrix4fv);
 			locGetUniformLocation = OGL_LOAD(locGetUniformLocation_t, glGetUniformLocation);
 #if !defined(OLC_PLATFORM_EMSCRIPTEN)
@@ -5871,6 +8911,20 @@ namespace olc
 			locBindVertexArray = glBindVertexArrayOES;
 			locGenVertexArrays = glGenVertexArraysOES;
 #endif
+#if !defined(OLC_PLATFORM_EMSCRIPTEN)
+			locVertexAttribDivisor = OGL_LOAD(locVertexAttribDivisor_t, glVertexAttribDivisor);
+			locDrawArraysInstanced = OGL_LOAD(locDrawArraysInstanced_t, glDrawArraysInstanced);
+#else
+			locVertexAttribDivisor = glVertexAttribDivisorEXT;
+			locDrawArraysInstanced = glDrawArraysInstancedEXT;
+#endif
+#if !defined(OLC_PLATFORM_EMSCRIPTEN)
+			locMapBufferRange = OGL_LOAD(locMapBufferRange_t, glMapBufferRange);
+			locUnmapBuffer = OGL_LOAD(locUnmapBuffer_t, glUnmapBuffer);
+			locFenceSync = OGL_LOAD(locFenceSync_t, glFenceSync);
+			locClientWaitSync = OGL_LOAD(locClientWaitSync_t, glClientWaitSync);
+			locDeleteSync = OGL_LOAD(locDeleteSync_t, glDeleteSync);
+#endif
 
 			// Load & Compile Quad Shader - assumes no errors
 			m_nFS = locCreateShader(0x8B30);
@@ -5924,17 +8978,79 @@ namespace olc
 
 			// Create Quad
 			locGenBuffers(1, &m_vbQuad);
+			locGenBuffers(1, &m_ibQuad);
 			locGenVertexArrays(1, &m_vaQuad);
 			locBindVertexArray(m_vaQuad);
 			locBindBuffer(0x8892, m_vbQuad);
+			locBindBuffer(0x8893, m_ibQuad);
 
-			locVertex verts[OLC_MAX_VERTS];
-			locBufferData(0x8892, sizeof(locVertex) * OLC_MAX_VERTS, verts, 0x88E0);
+			// Allocate the streams, see Stream()
+			locBufferData(0x8892, GLsizeiptr(m_streamVerts.nCapacity * sizeof(locVertex)), nullptr, 0x88E0);
+			locBufferData(0x8893, GLsizeiptr(m_streamIndices.nCapacity * sizeof(uint32_t)), nullptr, 0x88E0);
 			locVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, sizeof(locVertex), 0); locEnableVertexAttribArray(0);
 			locVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(locVertex), (void*)(4 * sizeof(float))); locEnableVertexAttribArray(1);
 			locVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(locVertex), (void*)(6 * sizeof(float)));	locEnableVertexAttribArray(2);
 			locBindBuffer(0x8892, 0);
 			locBindVertexArray(0);
+			m_streamVerts.nBuffer = m_vbQuad;
+			m_streamIndices.nBuffer = m_ibQuad;
+
+			// Load & Compile Instance Shader, sharing the quad fragment shader
+			m_nInstVS = locCreateShader(0x8B31);
+			const GLchar* strInstVS =
+#if defined(__arm__) || defined(OLC_PLATFORM_EMSCRIPTEN)
+				"#version 300 es\n"
+				"precision highp float;"
+#else
+				"#version 330 core\n"
+#endif
+				"layout(location = 0) in vec2 iPos;\n"
+				"layout(location = 1) in vec2 iScale;\n"
+				"layout(location = 2) in float iAngle;\n"
+				"layout(location = 3) in vec2 iCenter;\n"
+				"layout(location = 4) in vec2 iSrcPos;\n"
+				"layout(location = 5) in vec2 iSrcSize;\n"
+				"layout(location = 6) in vec4 iTint;\n"
+				"uniform vec2 ndc;\n"
+				"uniform vec2 decalSize;\n"
+				"uniform vec4 uvMap;\n"
+				"out vec2 oTex;\n"
+				"out vec4 oCol;\n"
+				"void main(){"
+				"vec2 corner = vec2(gl_VertexID >= 2 ? 1.0 : 0.0, (gl_VertexID == 1 || gl_VertexID == 2) ? 1.0 : 0.0);"
+				"bool whole = iSrcSize.x == 0.0 && iSrcSize.y == 0.0;"
+				"vec2 size = whole ? decalSize : iSrcSize;"
+				"vec2 l = (corner * size - iCenter) * iScale;"
+				"float c = cos(iAngle); float s = sin(iAngle);"
+				"vec2 p = iPos + vec2(l.x * c - l.y * s, l.x * s + l.y * c);"
+				"gl_Position = vec4(p.x * ndc.x - 1.0, 1.0 - p.y * ndc.y, 0.0, 1.0);"
+				"oTex = uvMap.xy + ((whole ? vec2(0.0) : iSrcPos) + corner * size) * uvMap.zw;"
+				"oCol = iTint;}";
+			locShaderSource(m_nInstVS, 1, &strInstVS, NULL);
+			locCompileShader(m_nInstVS);
+
+			m_nInstShader = locCreateProgram();
+			locAttachShader(m_nInstShader, m_nFS);
+			locAttachShader(m_nInstShader, m_nInstVS);
+			locLinkProgram(m_nInstShader);
+			m_uniInstNDC = locGetUniformLocation(m_nInstShader, "ndc");
+			m_uniInstSize = locGetUniformLocation(m_nInstShader, "decalSize");
+			m_uniInstUV = locGetUniformLocation(m_nInstShader, "uvMap");
+
+			// Instance attributes are pointed at the right part of the stream per draw
+			locGenBuffers(1, &m_vbInstance);
+			locGenVertexArrays(1, &m_vaInstance);
+			locBindVertexArray(m_vaInstance);
+			locBindBuffer(0x8892, m_vbInstance);
+			locBufferData(0x8892, GLsizeiptr(m_streamInstances.nCapacity * sizeof(olc::InstanceData)), nullptr, 0x88E0);
+			for (GLuint i = 0; i < 7; i++)
+			{
+				locEnableVertexAttribArray(i);
+				locVertexAttribDivisor(i, 1);
+			}
+			locBindVertexArray(0);
+			locBindBuffer(0x8892, 0);
+			m_streamInstances.nBuffer = m_vbInstance;
 
 			// Create blank texture for spriteless decals
 			rendBlankQuad.Create(1, 1);
@@ -5972,6 +9088,10 @@ namespace olc
 
 		void DisplayFrame() override
 		{
+			Flush();
+			m_statsLast = m_statsFrame;
+			m_statsFrame = olc::RendererStats();
+
 #if defined(OLC_PLATFORM_WINAPI)
 			SwapBuffers(glDeviceContext);
 			if (bSync) DwmFlush(); // Woooohooooooo!!!! SMOOOOOOOTH!
@@ -5990,15 +9110,22 @@ namespace olc
 #endif
 		}
 
+		void SubmitFrame() override
+		{
+			Flush();
+			glFlush();
+		}
+
 		void PrepareDrawing() override
 		{
-			glEnable(GL_BLEND);
-			nDecalMode = DecalMode::NORMAL;
-			glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-			locUseProgram(m_nQuadShader);
-			locBindVertexArray(m_vaQuad);
-			float f[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
-			locUniform4fv(m_uniTint, 1, f);
+			Flush();
+
+			// Anything could have happened to the state since the last frame
+			InvalidateState();
+			SetCapability(GL_BLEND, m_state.bBlend, true);
+			SetDecalMode(DecalMode::NORMAL);
+			UseQuadShader();
+			BindBuffer(0x8892, m_vbQuad);
 
 #if defined(OLC_PLATFORM_EMSCRIPTEN)
 			locVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, sizeof(locVertex), 0); locEnableVertexAttribArray(0);
@@ -6006,16 +9133,29 @@ namespace olc
 			locVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(locVertex), (void*)(6 * sizeof(float)));	locEnableVertexAttribArray(2);
 #endif
 
-			locUniform1i(m_uniIs3D, 0);
-			locUniformMatrix4fv(m_uniMVP, 1, false, matProjection.data());
-			glDisable(GL_CULL_FACE);
-			glDepthFunc(GL_LESS);
+			if (Changed(m_state.fMVP, matProjection)) locUniformMatrix4fv(m_uniMVP, 1, false, matProjection.data());
+			if (Changed(m_state.nDepthFunc, GLenum(GL_LESS))) glDepthFunc(GL_LESS);
+		}
+
+		void InvalidateState() override
+		{
+			Flush();
+			m_state = StateCache();
+			nDecalMode = olc::DecalMode(-1);
+		}
+
+		olc::RendererStats GetStats() const override
+		{
+			return m_statsLast;
 		}
 
 		void SetDecalMode(const olc::DecalMode& mode) override
 		{
-			if (mode != nDecalMode)
+			if (mode == nDecalMode)
+				m_statsFrame.nStateCallsSkipped++;
+			else
 			{
+				m_statsFrame.nStateCalls++;
 				switch (mode)
 				{
 				case olc::DecalMode::NORMAL: glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);	break;
@@ -6032,8 +9172,7 @@ namespace olc
 
 		void DrawLayerQuad(const olc::vf2d& offset, const olc::vf2d& scale, const olc::Pixel tint) override
 		{
-			glDisable(GL_CULL_FACE);
-			locBindBuffer(0x8892, m_vbQuad);
+			Flush();
 			locVertex verts[4] = {
 				{{-1.0f, -1.0f, 1.0, 0.0}, {0.0f * scale.x + offset.x, 1.0f * scale.y + offset.y}, tint},
 				{{+1.0f, -1.0f, 1.0, 0.0}, {1.0f * scale.x + offset.x, 1.0f * scale.y + offset.y}, tint},
@@ -6041,47 +9180,103 @@ namespace olc
 				{{+1.0f, +1.0f, 1.0, 0.0}, {1.0f * scale.x + offset.x, 0.0f * scale.y + offset.y}, tint},
 			};
 
-			locBufferData(0x8892, sizeof(locVertex) * 4, verts, 0x88E0);
-
-			locUniform1i(m_uniIs3D, 0);
-			float f[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
-			locUniform4fv(m_uniTint, 1, f);
-			glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+			UseQuadShader();
+			const size_t nFirst = Stream(m_streamVerts, verts, 4);
+			DrawArrays(GL_TRIANGLE_STRIP, GLint(nFirst), 4);
 		}
 
 		void DrawDecal(const olc::DecalInstance& decal) override
 		{
-			glDisable(GL_CULL_FACE);
-			SetDecalMode(decal.mode);
-			if (decal.decal == nullptr)
-				glBindTexture(GL_TEXTURE_2D, rendBlankQuad.Decal()->id);
-			else
-				glBindTexture(GL_TEXTURE_2D, decal.decal->id);
+			const uint32_t nTexture = decal.decal == nullptr ? rendBlankQuad.Decal()->id : decal.decal->id;
+			const bool bLines = decal.mode == DecalMode::WIREFRAME || decal.structure == olc::DecalStructure::LINE;
 
-			locBindBuffer(0x8892, m_vbQuad);
+			// Anything that would change GL state ends the batch
+			if (!vBatchIndices.empty() && (nTexture != nBatchTexture || decal.mode != nBatchMode || bLines != bBatchLines))
+				Flush();
+
+			nBatchTexture = nTexture;
+			nBatchMode = decal.mode;
+			bBatchLines = bLines;
 
+			const uint32_t nBase = uint32_t(vBatchVerts.size());
 			for (uint32_t i = 0; i < decal.points; i++)
-				pVertexMem[i] = { { decal.pos[i].x, decal.pos[i].y, decal.w[i], 0.0 }, { decal.uv[i].x, decal.uv[i].y }, decal.tint[i] };
+				vBatchVerts.push_back({ { decal.pos[i].x, decal.pos[i].y, decal.w[i], 0.0 }, { decal.uv[i].x, decal.uv[i].y }, decal.tint[i] });
 
-			locBufferData(0x8892, sizeof(locVertex) * decal.points, pVertexMem, 0x88E0);
-			locUniform1i(m_uniIs3D, 0);
+			// Fans, strips and loops are unrolled into lists so they can share a draw
+			const uint32_t n = decal.points;
+			auto tri = [&](uint32_t a, uint32_t b, uint32_t c) { vBatchIndices.insert(vBatchIndices.end(), { nBase + a, nBase + b, nBase + c }); };
+			auto line = [&](uint32_t a, uint32_t b) { vBatchIndices.insert(vBatchIndices.end(), { nBase + a, nBase + b }); };
 
-			float f[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
-			locUniform4fv(m_uniTint, 1, f);
+			if (decal.mode == DecalMode::WIREFRAME)
+			{
+				if (n >= 2) for (uint32_t i = 0; i < n; i++) line(i, (i + 1) % n);
+			}
+			else if (decal.structure == olc::DecalStructure::FAN)
+				for (uint32_t i = 2; i < n; i++) tri(0, i - 1, i);
+			else if (decal.structure == olc::DecalStructure::STRIP)
+				for (uint32_t i = 2; i < n; i++) { if (i & 1) tri(i - 1, i - 2, i); else tri(i - 2, i - 1, i); }
+			else if (decal.structure == olc::DecalStructure::LIST)
+				for (uint32_t i = 2; i < n; i += 3) tri(i - 2, i - 1, i);
+			else if (decal.structure == olc::DecalStructure::LINE)
+				for (uint32_t i = 1; i < n; i += 2) line(i - 1, i);
+		}
 
-			if (nDecalMode == DecalMode::WIREFRAME)
-				glDrawArrays(GL_LINE_LOOP, 0, decal.points);
-			else
+		void Flush() override
+		{
+			if (vBatchIndices.empty())
 			{
-				if (decal.structure == olc::DecalStructure::FAN)
-					glDrawArrays(GL_TRIANGLE_FAN, 0, decal.points);
-				else if (decal.structure == olc::DecalStructure::STRIP)
-					glDrawArrays(GL_TRIANGLE_STRIP, 0, decal.points);
-				else if (decal.structure == olc::DecalStructure::LIST)
-					glDrawArrays(GL_TRIANGLES, 0, decal.points);
-				else if (decal.structure == olc::DecalStructure::LINE)
-					glDrawArrays(GL_LINES, 0, decal.points);
+				vBatchVerts.clear();
+				return;
 			}
+
+			SetDecalMode(nBatchMode);
+			BindTexture(nBatchTexture);
+			UseQuadShader();
+
+			// Indices are relative to the batch, so move them to wherever
+			// the vertices landed in the stream
+			const uint32_t nFirstVertex = uint32_t(Stream(m_streamVerts, vBatchVerts.data(), vBatchVerts.size()));
+			for (auto& i : vBatchIndices) i += nFirstVertex;
+			const size_t nFirstIndex = Stream(m_streamIndices, vBatchIndices.data(), vBatchIndices.size());
+
+			glDrawElements(bBatchLines ? GL_LINES : GL_TRIANGLES, GLsizei(vBatchIndices.size()), GL_UNSIGNED_INT, (void*)(nFirstIndex * sizeof(uint32_t)));
+			m_statsFrame.nDrawCalls++;
+
+			vBatchVerts.clear();
+			vBatchIndices.clear();
+		}
+
+		void DrawDecalInstanced(const olc::DecalInstance& decal, const olc::vf2d& vInvScreen) override
+		{
+			Flush();
+			SetDecalMode(decal.mode);
+			BindTexture(decal.decal->id);
+			SetCapability(GL_CULL_FACE, m_state.bCullFace, false);
+			SetCapability(GL_DEPTH_TEST, m_state.bDepthTest, false);
+
+			UseProgram(m_nInstShader);
+			BindVertexArray(m_vaInstance);
+
+			const size_t nFirst = Stream(m_streamInstances, decal.instances, decal.instanceCount);
+			const size_t nBase = nFirst * sizeof(olc::InstanceData);
+			const GLsizei nStride = sizeof(olc::InstanceData);
+			locVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, nStride, (void*)(nBase + offsetof(olc::InstanceData, pos)));
+			locVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, nStride, (void*)(nBase + offsetof(olc::InstanceData, scale)));
+			locVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, nStride, (void*)(nBase + offsetof(olc::InstanceData, fAngle)));
+			locVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, nStride, (void*)(nBase + offsetof(olc::InstanceData, center)));
+			locVertexAttribPointer(4, 2, GL_FLOAT, GL_FALSE, nStride, (void*)(nBase + offsetof(olc::InstanceData, source_pos)));
+			locVertexAttribPointer(5, 2, GL_FLOAT, GL_FALSE, nStride, (void*)(nBase + offsetof(olc::InstanceData, source_size)));
+			locVertexAttribPointer(6, 4, GL_UNSIGNED_BYTE, GL_TRUE, nStride, (void*)(nBase + offsetof(olc::InstanceData, tint)));
+
+			const std::array<float, 2> fNDC = { 2.0f * vInvScreen.x, 2.0f * vInvScreen.y };
+			const std::array<float, 2> fSize = { float(decal.decal->sprite->width), float(decal.decal->sprite->height) };
+			const std::array<float, 4> fUV = { decal.decal->vUVOffset.x, decal.decal->vUVOffset.y, decal.decal->vUVScale.x, decal.decal->vUVScale.y };
+			if (Changed(m_state.fInstNDC, fNDC)) locUniform2fv(m_uniInstNDC, 1, fNDC.data());
+			if (Changed(m_state.fInstSize, fSize)) locUniform2fv(m_uniInstSize, 1, fSize.data());
+			if (Changed(m_state.fInstUV, fUV)) locUniform4fv(m_uniInstUV, 1, fUV.data());
+
+			locDrawArraysInstanced(decal.mode == DecalMode::WIREFRAME ? GL_LINE_LOOP : GL_TRIANGLE_FAN, 0, 4, GLsizei(decal.instanceCount));
+			m_statsFrame.nDrawCalls++;
 		}
 
 		uint32_t CreateTexture(const uint32_t width, const uint32_t height, const bool filtered, const bool clamp) override
@@ -6090,7 +9285,7 @@ namespace olc
 			UNUSED(height);
 			uint32_t id = 0;
 			glGenTextures(1, &id);
-			glBindTexture(GL_TEXTURE_2D, id);
+			ApplyTexture(id);
 
 			if (filtered)
 			{
@@ -6121,28 +9316,110 @@ namespace olc
 
 		uint32_t DeleteTexture(const uint32_t id) override
 		{
+			Flush();
 			glDeleteTextures(1, &id);
+			// Deleting the bound texture unbinds it
+			if (m_state.nTexture.value == id) m_state.nTexture.value = 0;
 			return id;
 		}
 
 		void UpdateTexture(uint32_t id, olc::Sprite* spr) override
 		{
 			UNUSED(id);
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, spr->width, spr->height, 0, GL_RGBA, GL_UNSIGNED_BYTE, spr->GetData());
+			Flush();
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, spr->width, spr->height, 0, GL_RGBA, GL_UNSIGNED_BYTE, spr->pColData.data());
+		}
+
+		void UpdateTextureRegion(uint32_t id, olc::Sprite* spr, const olc::vi2d& pos, const olc::vi2d& size) override
+		{
+			UNUSED(id);
+			Flush();
+			glPixelStorei(GL_UNPACK_ROW_LENGTH, spr->width);
+			glTexSubImage2D(GL_TEXTURE_2D, 0, pos.x, pos.y, size.x, size.y, GL_RGBA, GL_UNSIGNED_BYTE, spr->pColData.data() + size_t(pos.y) * spr->width + pos.x);
+			glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
 		}
 
 		void ReadTexture(uint32_t id, olc::Sprite* spr) override
 		{
-			glReadPixels(0, 0, spr->width, spr->height, GL_RGBA, GL_UNSIGNED_BYTE, spr->GetData());
+			Flush();
+			glReadPixels(0, 0, spr->width, spr->height, GL_RGBA, GL_UNSIGNED_BYTE, spr->pColData.data());
+		}
+
+#if !defined(OLC_PLATFORM_EMSCRIPTEN)
+		uint32_t UpdateTextureAsync(uint32_t id, olc::Sprite* spr) override
+		{
+			UNUSED(id);
+			Flush();
+			PixelTransfer& t = NextTransfer(m_pboUpload, m_nNextUpload);
+			const size_t nBytes = spr->pColData.size() * sizeof(olc::Pixel);
+
+			// Orphan the old storage, copy the sprite in, and let the GPU pull it
+			// into the texture whenever it gets round to it
+			locBindBuffer(0x88EC, t.nBuffer);
+			locBufferData(0x88EC, GLsizeiptr(nBytes), nullptr, 0x88E0);
+			void* pData = locMapBufferRange(0x88EC, 0, GLsizeiptr(nBytes), 0x0002 | 0x0008);
+			if (pData) std::memcpy(pData, spr->pColData.data(), nBytes);
+			locUnmapBuffer(0x88EC);
+			glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, spr->width, spr->height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+			locBindBuffer(0x88EC, 0);
+
+			t.fence = locFenceSync(0x9117, 0);
+			return t.nTicket;
+		}
+
+		uint32_t ReadTextureAsync(uint32_t id, olc::Sprite* spr) override
+		{
+			UNUSED(id);
+			Flush();
+			PixelTransfer& t = NextTransfer(m_pboRead, m_nNextRead);
+			t.pSprite = spr;
+			t.vSize = spr->Size();
+
+			locBindBuffer(0x88EB, t.nBuffer);
+			locBufferData(0x88EB, GLsizeiptr(spr->pColData.size() * sizeof(olc::Pixel)), nullptr, 0x88E1);
+			glReadPixels(0, 0, spr->width, spr->height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+			locBindBuffer(0x88EB, 0);
+
+			t.fence = locFenceSync(0x9117, 0);
+			return t.nTicket;
+		}
+
+		bool TransferComplete(uint32_t nTicket, bool bWait) override
+		{
+			for (auto& t : m_pboUpload)
+				if (t.nTicket == nTicket)
+				{
+					if (!WaitTransfer(t, bWait)) return false;
+					t.nTicket = 0;
+					return true;
+				}
+
+			for (auto& t : m_pboRead)
+				if (t.nTicket == nTicket)
+				{
+					if (!WaitTransfer(t, bWait)) return false;
+					FinishRead(t);
+					return true;
+				}
+
+			// Unknown tickets were finished off when their buffer was reused
+			return true;
 		}
+#endif
 
 		void ApplyTexture(uint32_t id) override
 		{
+			// Always bound, as this comes before uploads and texture setup, which may follow
+			// code from outside the renderer binding textures of its own
+			Flush();
 			glBindTexture(GL_TEXTURE_2D, id);
+			m_state.nTexture = { id, true };
+			m_statsFrame.nStateCalls++;
 		}
 
 		void ClearBuffer(olc::Pixel p, bool bDepth) override
 		{
+			Flush();
 			glClearColor(float(p.r) / 255.0f, float(p.g) / 255.0f, float(p.b) / 255.0f, float(p.a) / 255.0f);
 			glClear(GL_COLOR_BUFFER_BIT);
 			if (bDepth) glClear(GL_DEPTH_BUFFER_BIT);
@@ -6150,6 +9427,7 @@ namespace olc
 
 		void UpdateViewport(const olc::vi2d& pos, const olc::vi2d& size) override
 		{
+			Flush();
 			glViewport(pos.x, pos.y, size.x, size.y);
 		}
 
@@ -6160,22 +9438,18 @@ namespace olc
 
 		void DoGPUTask(const olc::GPUTask& task) override
 		{
+			Flush();
 			SetDecalMode(task.mode);
-			if (task.decal == nullptr)
-				glBindTexture(GL_TEXTURE_2D, rendBlankQuad.Decal()->id);
-			else
-				glBindTexture(GL_TEXTURE_2D, task.decal->id);
-
-			locBindBuffer(0x8892, m_vbQuad);
-
-			//for (uint32_t i = 0; i < task.vb.size; i++)
-			// pVertexMem[i] = { { decal.pos[i].x, decal.pos[i].y, decal.w[i] }, { decal.uv[i].x, decal.uv[i].y }, decal.tint[i] };
+			BindTexture(task.decal == nullptr ? rendBlankQuad.Decal()->id : task.decal->id);
+			UseProgram(m_nQuadShader);
+			BindVertexArray(m_vaQuad);
 
 			// ooooof... f^%ing win!!! B) [planned of course]
-			locBufferData(0x8892, sizeof(GPUTask::Vertex) * task.vb.size(), task.vb.data(), 0x88E0);
+			static_assert(sizeof(GPUTask::Vertex) == sizeof(locVertex), "GPUTask::Vertex must match locVertex");
+			const GLint nFirst = GLint(Stream(m_streamVerts, task.vb.data(), task.vb.size()));
 
 			// Use 3D Shader
-			locUniform1i(m_uniIs3D, 1);
+			if (Changed(m_state.nIs3D, 1)) locUniform1i(m_uniIs3D, 1);
 
 			// Use MVP Matrix - yeah, but this needs to happen somewhere
 			// and at least its per object which makes sense
@@ -6187,49 +9461,33 @@ namespace olc
 					+ matProjection[1 * 4 + r] * task.mvp[c * 4 + 1]
 					+ matProjection[2 * 4 + r] * task.mvp[c * 4 + 2]
 					+ matProjection[3 * 4 + r] * task.mvp[c * 4 + 3];
-			locUniformMatrix4fv(m_uniMVP, 1, false, matMVP.data());
+			if (Changed(m_state.fMVP, matMVP)) locUniformMatrix4fv(m_uniMVP, 1, false, matMVP.data());
 
-			float f[4] = { float(task.tint.r) / 255.0f, float(task.tint.g) / 255.0f, float(task.tint.b) / 255.0f, float(task.tint.a) / 255.0f };
-			locUniform4fv(m_uniTint, 1, f);
+			const std::array<float, 4> f = { float(task.tint.r) / 255.0f, float(task.tint.g) / 255.0f, float(task.tint.b) / 255.0f, float(task.tint.a) / 255.0f };
+			if (Changed(m_state.fTint, f)) locUniform4fv(m_uniTint, 1, f.data());
 
-			
-			if (task.cull == olc::CullMode::NONE)
-			{
+			// Cull state is left as it is, the 2D paths turn it off again if they need to
+			SetCapability(GL_CULL_FACE, m_state.bCullFace, task.cull != olc::CullMode::NONE);
+			if (task.cull == olc::CullMode::CW && Changed(m_state.nCullFace, GLenum(GL_FRONT)))
 				glCullFace(GL_FRONT);
-				glDisable(GL_CULL_FACE);
-			}
-			else if(task.cull == olc::CullMode::CW)
-			{
-				glCullFace(GL_FRONT);
-				glEnable(GL_CULL_FACE);
-			}
-			else if (task.cull == olc::CullMode::CCW)
-			{
+			else if (task.cull == olc::CullMode::CCW && Changed(m_state.nCullFace, GLenum(GL_BACK)))
 				glCullFace(GL_BACK);
-				glEnable(GL_CULL_FACE);
-			}
-
-			if(task.depth)
-				glEnable(GL_DEPTH_TEST);
 
-			
+			SetCapability(GL_DEPTH_TEST, m_state.bDepthTest, task.depth);
 
 			if (nDecalMode == DecalMode::WIREFRAME)
-				glDrawArrays(GL_LINE_LOOP, 0, (GLsizei)task.vb.size());
+				DrawArrays(GL_LINE_LOOP, nFirst, (GLsizei)task.vb.size());
 			else
 			{
 				if (task.structure == olc::DecalStructure::FAN)
-					glDrawArrays(GL_TRIANGLE_FAN, 0, (GLsizei)task.vb.size());
+					DrawArrays(GL_TRIANGLE_FAN, nFirst, (GLsizei)task.vb.size());
 				else if (task.structure == olc::DecalStructure::STRIP)
-					glDrawArrays(GL_TRIANGLE_STRIP, 0, (GLsizei)task.vb.size());
+					DrawArrays(GL_TRIANGLE_STRIP, nFirst, (GLsizei)task.vb.size());
 				else if (task.structure == olc::DecalStructure::LIST)
-					glDrawArrays(GL_TRIANGLES, 0, (GLsizei)task.vb.size());
+					DrawArrays(GL_TRIANGLES, nFirst, (GLsizei)task.vb.size());
 				else if (task.structure == olc::DecalStructure::LINE)
-					glDrawArrays(GL_LINES, 0, (GLsizei)task.vb.size());
+					DrawArrays(GL_LINES, nFirst, (GLsizei)task.vb.size());
 			}
-
-			if(task.depth)
-				glDisable(GL_DEPTH_TEST);
 		}
 	};
 }
@@ -6323,8 +9581,8 @@ namespace olc
 			if (pack != nullptr)
 			{
 				// Load sprite from input stream
-				ResourceBuffer rb = pack->GetFileBuffer(sImageFile);
-				bmp = Gdiplus::Bitmap::FromStream(SHCreateMemStream((BYTE*)rb.vMemory.data(), UINT(rb.vMemory.size())));
+				ResourceView rv = pack->GetFileView(sImageFile);
+				bmp = Gdiplus::Bitmap::FromStream(SHCreateMemStream((const BYTE*)rv.data(), UINT(rv.size())));
 			}
 			else
 			{
@@ -6354,7 +9612,7 @@ namespace olc
 
 		olc::rcode SaveImageResource(olc::Sprite* spr, const std::string& sImageFile) override
 		{
-			return olc::rcode::OK;
+			return SaveEncodedImage(spr, sImageFile);
 		}
 	};
 }
@@ -6461,7 +9719,7 @@ namespace olc
 			}
 			else
 			{
-				ResourceBuffer rb = pack->GetFileBuffer(sImageFile);
+				ResourceViewBuffer rb(pack->GetFileView(sImageFile));
 				std::istream is(&rb);
 				png_set_read_fn(png, (png_voidp)&is, pngReadStream);
 				loadPNG();
@@ -6478,7 +9736,7 @@ namespace olc
 
 		olc::rcode SaveImageResource(olc::Sprite* spr, const std::string& sImageFile) override
 		{
-			return olc::rcode::OK;
+			return SaveEncodedImage(spr, sImageFile);
 		}
 	};
 }
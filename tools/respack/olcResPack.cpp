@@ -0,0 +1,204 @@
+/*
+	olcResPack.cpp
+
+	+-------------------------------------------------------------+
+	|         OneLoneCoder Pixel Game Engine Tool                 |
+	|                 Resource Packer v1.0                        |
+	+-------------------------------------------------------------+
+
+	What is this?
+	~~~~~~~~~~~~~
+	Builds, lists, checks and unpacks olc::ResourcePack files from the
+	command line. Packs are written in version 2 format, and both
+	versions can be read.
+
+		olcResPack pack <pack> [-k key] [-c] [-n] <files or folders...>
+		olcResPack list <pack> [-k key]
+		olcResPack verify <pack> [-k key]
+		olcResPack unpack <pack> <folder> [-k key]
+
+	Folders are added with everything in them. -c compresses the files that
+	follow it, -n stops compressing again. Files are stored under the path
+	given, so run it from wherever your program will load them from.
+
+	Verify unpacks every file and checks it against its checksum, so
+	packing, verifying and unpacking again is a full round trip.
+
+	Build
+	~~~~~
+	It only needs the engine's header, and no window:
+
+		g++ -std=c++17 -O2 olcResPack.cpp -o olcResPack -lpthread
+
+	License (OLC-3)
+	~~~~~~~~~~~~~~~
+
+	Copyright 2018 - 2024 OneLoneCoder.com
+
+	Redistribution and use in source and binary forms, with or without
+	modification, are permitted provided that the following conditions
+	are met:
+
+	1. Redistributions or derivations of source code must retain the above
+	copyright notice, this list of conditions and the following disclaimer.
+
+	2. Redistributions or derivative works in binary form must reproduce
+	the above copyright notice. This list of conditions and the following
+	disclaimer must be reproduced in the documentation and/or other
+	materials provided with the distribution.
+
+	3. Neither the name of the copyright holder nor the names of its
+	contributors may be used to endorse or promote products derived
+	from this software without specific prior written permission.
+
+	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+	A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+	HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+	SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+	LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+	DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+	THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+	(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+	OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+	Author
+	~~~~~~
+	David Barr, aka javidx9, ©OneLoneCoder 2019, 2020, 2021, 2022, 2023, 2024
+
+	Revisions:
+	1.00:	Initial Release
+*/
+
+#ifndef OLC_PGE_HEADLESS
+#define OLC_PGE_HEADLESS
+#endif
+#define OLC_PGE_APPLICATION
+#include "../../olcPixelGameEngine.h"
+
+int Usage()
+{
+	std::cout << "Usage:\n"
+		<< "  olcResPack pack <pack> [-k key] [-c] [-n] <files or folders...>\n"
+		<< "  olcResPack list <pack> [-k key]\n"
+		<< "  olcResPack verify <pack> [-k key]\n"
+		<< "  olcResPack unpack <pack> <folder> [-k key]\n";
+	return 1;
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc < 3) return Usage();
+
+	const std::string sCommand = argv[1];
+	const std::string sPack = argv[2];
+
+	// Pull out the key, everything else is the command's own
+	std::string sKey;
+	std::vector<std::string> vArgs;
+	for (int i = 3; i < argc; i++)
+	{
+		if (std::string(argv[i]) == "-k" && i + 1 < argc)
+			sKey = argv[++i];
+		else
+			vArgs.push_back(argv[i]);
+	}
+
+	olc::ResourcePack pack;
+
+	if (sCommand == "pack")
+	{
+		bool bCompress = false;
+		size_t nFiles = 0;
+		for (const auto& sArg : vArgs)
+		{
+			if (sArg == "-c") { bCompress = true; continue; }
+			if (sArg == "-n") { bCompress = false; continue; }
+
+			if (_gfs::is_directory(sArg))
+			{
+				for (const auto& entry : _gfs::recursive_directory_iterator(sArg))
+				{
+					if (_gfs::is_regular_file(entry.path()) && pack.AddFile(entry.path().string(), bCompress))
+						nFiles++;
+				}
+			}
+			else if (pack.AddFile(sArg, bCompress))
+				nFiles++;
+			else
+				std::cout << "Not found: " << sArg << "\n";
+		}
+
+		if (!pack.SavePack(sPack, sKey))
+		{
+			std::cout << "Failed to write " << sPack << "\n";
+			return 1;
+		}
+		std::cout << "Packed " << nFiles << " files into " << sPack << "\n";
+		return 0;
+	}
+
+	if (!pack.LoadPack(sPack, sKey))
+	{
+		std::cout << "Failed to load " << sPack << ", is the key right?\n";
+		return 1;
+	}
+
+	if (sCommand == "list")
+	{
+		for (const auto& sFile : pack.GetFileList())
+			std::cout << sFile << "\n";
+		return 0;
+	}
+
+	if (sCommand == "verify")
+	{
+		const bool bOK = pack.VerifyPack();
+		std::cout << sPack << (bOK ? " is OK\n" : " is damaged\n");
+		return bOK ? 0 : 1;
+	}
+
+	if (sCommand == "unpack" && vArgs.size() == 1)
+	{
+		const _gfs::path folder = vArgs[0];
+		for (const auto& sFile : pack.GetFileList())
+		{
+			// Resolve "." and ".." here, so no name in the pack can write outside folder
+			std::vector<_gfs::path> vParts;
+			bool bEscapes = false;
+			for (const auto& part : _gfs::path(sFile).relative_path())
+			{
+				if (part == "..")
+				{
+					if (vParts.empty()) bEscapes = true;
+					else vParts.pop_back();
+				}
+				else if (!part.empty() && part != ".")
+					vParts.push_back(part);
+			}
+
+			if (bEscapes || vParts.empty())
+			{
+				std::cout << "Refusing to unpack " << sFile << ", it is outside " << folder.string() << "\n";
+				return 1;
+			}
+
+			_gfs::path file = folder;
+			for (const auto& part : vParts) file /= part;
+			_gfs::create_directories(file.parent_path());
+
+			olc::ResourceView rv = pack.GetFileView(sFile);
+			std::ofstream ofs(file, std::ofstream::binary);
+			ofs.write((const char*)rv.data(), std::streamsize(rv.size()));
+			if (!ofs)
+			{
+				std::cout << "Failed to write " << file.string() << "\n";
+				return 1;
+			}
+		}
+		return 0;
+	}
+
+	return Usage();
+}
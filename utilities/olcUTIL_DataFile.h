@@ -243,162 +243,164 @@ namespace olc::utils
 			// Open the file!
 			std::ifstream file(sFileName);
 			if (file.is_open())
+				return Read(n, file, sListSep);
+
+			// File not found, so fail
+			return false;
+		}
+
+		// Reads from any stream, eg a file in a ResourcePack via olc::ResourceViewBuffer
+		inline static bool Read(datafile& n, std::istream& is, const char sListSep = ',')
+		{
+			// These variables are outside of the read loop, as we will
+			// need to refer to previous iteration values in certain conditions
+			std::string sPropName = "";
+			std::string sPropValue = "";
+
+			// The file is fundamentally structured as a stack, so we will read it
+			// in a such, but note the data structure in memory is not explicitly
+			// stored in a stack, but one is constructed implicitly via the nodes
+			// owning other nodes (aka a tree)
+
+			// I dont want to accidentally create copies all over the place, nor do 
+			// I want to use pointer syntax, so being a bit different and stupidly
+			// using std::reference_wrapper, so I can store references to datafile
+			// nodes in a std::container.
+			std::stack<std::reference_wrapper<datafile>> stkPath;
+			stkPath.push(n);
+
+
+			// Read file line by line and process
+			while (!is.eof())
 			{
-				// These variables are outside of the read loop, as we will
-				// need to refer to previous iteration values in certain conditions
-				std::string sPropName = "";
-				std::string sPropValue = "";
-
-				// The file is fundamentally structured as a stack, so we will read it
-				// in a such, but note the data structure in memory is not explicitly
-				// stored in a stack, but one is constructed implicitly via the nodes
-				// owning other nodes (aka a tree)
-
-				// I dont want to accidentally create copies all over the place, nor do 
-				// I want to use pointer syntax, so being a bit different and stupidly
-				// using std::reference_wrapper, so I can store references to datafile
-				// nodes in a std::container.
-				std::stack<std::reference_wrapper<datafile>> stkPath;
-				stkPath.push(n);
-
-
-				// Read file line by line and process
-				while (!file.eof())
-				{
-					// Read line
-					std::string line;
-					std::getline(file, line);
+				// Read line
+				std::string line;
+				std::getline(is, line);
 
-					// This little lambda removes whitespace from
-					// beginning and end of supplied string
-					auto trim = [](std::string& s)
-					{
-						s.erase(0, s.find_first_not_of(" \t\n\r\f\v"));
-						s.erase(s.find_last_not_of(" \t\n\r\f\v") + 1);
-					};
+				// This little lambda removes whitespace from
+				// beginning and end of supplied string
+				auto trim = [](std::string& s)
+				{
+					s.erase(0, s.find_first_not_of(" \t\n\r\f\v"));
+					s.erase(s.find_last_not_of(" \t\n\r\f\v") + 1);
+				};
 
-					trim(line);
+				trim(line);
 
-					// If line has content
-					if (!line.empty())
+				// If line has content
+				if (!line.empty())
+				{
+					// Test if its a comment...
+					if (line[0] == '#')
 					{
-						// Test if its a comment...
-						if (line[0] == '#')
-						{
-							// ...it is a comment, so ignore
-							datafile comment;
-							comment.m_bIsComment = true;
-							stkPath.top().get().m_vecObjects.push_back({ line, comment });
-						}
-						else
+						// ...it is a comment, so ignore
+						datafile comment;
+						comment.m_bIsComment = true;
+						stkPath.top().get().m_vecObjects.push_back({ line, comment });
+					}
+					else
+					{
+						// ...it is content, so parse. Firstly, find if the line
+						// contains an assignment. If it does then it's a property...
+						size_t x = line.find_first_of('=');
+						if (x != std::string::npos)
 						{
-							// ...it is content, so parse. Firstly, find if the line
-							// contains an assignment. If it does then it's a property...
-							size_t x = line.find_first_of('=');
-							if (x != std::string::npos)
+							// ...so split up the property into a name, and its values!
+
+							// Extract the property name, which is all characters up to
+							// first assignment, trim any whitespace from ends
+							sPropName = line.substr(0, x);
+							trim(sPropName);
+
+							// Extract the property value, which is all characters after
+							// the first assignment operator, trim any whitespace from ends
+							sPropValue = line.substr(x + 1, line.size());
+							trim(sPropValue);
+
+							// The value may be in list form: a, b, c, d, e, f etc and some of those
+							// elements may exist in quotes a, b, c, "d, e", f. So we need to iterate
+							// character by character and break up the value
+							bool bInQuotes = false;
+							std::string sToken;
+							size_t nTokenCount = 0;
+							for (const auto c : sPropValue)
 							{
-								// ...so split up the property into a name, and its values!
-
-								// Extract the property name, which is all characters up to
-								// first assignment, trim any whitespace from ends
-								sPropName = line.substr(0, x);
-								trim(sPropName);
-
-								// Extract the property value, which is all characters after
-								// the first assignment operator, trim any whitespace from ends
-								sPropValue = line.substr(x + 1, line.size());
-								trim(sPropValue);
-
-								// The value may be in list form: a, b, c, d, e, f etc and some of those
-								// elements may exist in quotes a, b, c, "d, e", f. So we need to iterate
-								// character by character and break up the value
-								bool bInQuotes = false;
-								std::string sToken;
-								size_t nTokenCount = 0;
-								for (const auto c : sPropValue)
+								// Is character a quote...
+								if (c == '\"')
+								{
+									// ...yes, so toggle quote state
+									bInQuotes = !bInQuotes;
+								}
+								else
 								{
-									// Is character a quote...
-									if (c == '\"')
+									// ...no, so proceed creating token. If we are in quote state
+									// then just append characters until we exit quote state.
+									if (bInQuotes)
 									{
-										// ...yes, so toggle quote state
-										bInQuotes = !bInQuotes;
+										sToken.append(1, c);
 									}
 									else
 									{
-										// ...no, so proceed creating token. If we are in quote state
-										// then just append characters until we exit quote state.
-										if (bInQuotes)
+										// Is the character our seperator? If it is
+										if (c == sListSep)
 										{
-											sToken.append(1, c);
+											// Clean up the token
+											trim(sToken);
+											// Add it to the vector of values for this property
+											stkPath.top().get()[sPropName].SetString(sToken, nTokenCount);
+											// Reset our token state
+											sToken.clear();
+											nTokenCount++;
 										}
 										else
 										{
-											// Is the character our seperator? If it is
-											if (c == sListSep)
-											{
-												// Clean up the token
-												trim(sToken);
-												// Add it to the vector of values for this property
-												stkPath.top().get()[sPropName].SetString(sToken, nTokenCount);
-												// Reset our token state
-												sToken.clear();
-												nTokenCount++;
-											}
-											else
-											{
-												// It isnt, so just append to token
-												sToken.append(1, c);
-											}
+											// It isnt, so just append to token
+											sToken.append(1, c);
 										}
 									}
 								}
+							}
 
-								// Any residual characters at this point just make up the final token,
-								// so clean it up and add it to the vector of values
-								if (!sToken.empty())
-								{
-									trim(sToken);
-									stkPath.top().get()[sPropName].SetString(sToken, nTokenCount);
-								}
+							// Any residual characters at this point just make up the final token,
+							// so clean it up and add it to the vector of values
+							if (!sToken.empty())
+							{
+								trim(sToken);
+								stkPath.top().get()[sPropName].SetString(sToken, nTokenCount);
+							}
+						}
+						else
+						{
+							// ...but if it doesnt, then it's something structural
+							if (line[0] == '{')
+							{
+								// Open brace, so push this node to stack, subsequent properties
+								// will belong to the new node
+								stkPath.push(stkPath.top().get()[sPropName]);
 							}
 							else
 							{
-								// ...but if it doesnt, then it's something structural
-								if (line[0] == '{')
+								if (line[0] == '}')
 								{
-									// Open brace, so push this node to stack, subsequent properties
-									// will belong to the new node
-									stkPath.push(stkPath.top().get()[sPropName]);
+									// Close brace, so this node has been defined, pop it from the
+									// stack
+									stkPath.pop();
 								}
 								else
 								{
-									if (line[0] == '}')
-									{
-										// Close brace, so this node has been defined, pop it from the
-										// stack
-										stkPath.pop();
-									}
-									else
-									{
-										// Line is a property with no assignment. Who knows whether this is useful,
-										// but we can simply add it as a valueless property...
-										sPropName = line;
-										// ...actually it is useful, as valuless properties are typically
-										// going to be the names of new datafile nodes on the next iteration
-									}
+									// Line is a property with no assignment. Who knows whether this is useful,
+									// but we can simply add it as a valueless property...
+									sPropName = line;
+									// ...actually it is useful, as valuless properties are typically
+									// going to be the names of new datafile nodes on the next iteration
 								}
 							}
 						}
 					}
 				}
-
-				// Close and exit!
-				file.close();
-				return true;
 			}
 
-			// File not found, so fail
-			return false;
+			return true;
 		}
 
 	public: